@@ -27,20 +27,38 @@ win32: LIBS += -lm
 
 # Input
 HEADERS += dataeditorwidget.h \
+           besselintegral.h \
+           besselkernels.h \
            chartsetting1.h \
            chartsetting2.h \
            chartwidget.h \
            chartwindow.h \
+           computeruntime.h \
            datacalculate.h \
            datacolumndialog.h \
            dataimportdialog.h \
+           differentialevolution.h \
+           dimensionlesscurvecache.h \
+           dualnumber.h \
+           fitjob.h \
+           fitprogressslot.h \
+           fitscheduler.h \
            fittingdatadialog.h \
            fittingpage.h \
            fittingparameterchart.h \
+           gausskronrod.h \
+           laplaceinversion.h \
+           levenbergmarquardt.h \
+           logtimeresampler.h \
            modelmanager.h \
            modelparameter.h \
+           modelparamvector.h \
            modelselect.h \
+           modelsolver01-06.h \
            modelwidget01-06.h \
+           monotonecubic.h \
+           multistartfitter.h \
+           multistartresultdialog.h \
            mousezoom.h \
            newprojectdialog.h \
            paramselectdialog.h \
@@ -87,21 +105,37 @@ FORMS += dataeditorwidget.ui \
          wt_projectwidget.ui
 
 SOURCES += \
+           besselintegral.cpp \
+           besselkernels.cpp \
            chartsetting1.cpp \
            chartsetting2.cpp \
            chartwidget.cpp \
            chartwindow.cpp \
+           computeruntime.cpp \
            datacalculate.cpp \
            datacolumndialog.cpp \
            dataeditorwidget.cpp \
            dataimportdialog.cpp \
+           differentialevolution.cpp \
+           dimensionlesscurvecache.cpp \
+           fitjob.cpp \
+           fitprogressslot.cpp \
+           fitscheduler.cpp \
            fittingdatadialog.cpp \
            fittingpage.cpp \
            fittingparameterchart.cpp \
+           laplaceinversion.cpp \
+           levenbergmarquardt.cpp \
+           logtimeresampler.cpp \
            modelmanager.cpp \
            modelparameter.cpp \
+           modelparamvector.cpp \
            modelselect.cpp \
+           modelsolver01-06.cpp \
            modelwidget01-06.cpp \
+           monotonecubic.cpp \
+           multistartfitter.cpp \
+           multistartresultdialog.cpp \
            mousezoom.cpp \
            newprojectdialog.cpp \
            paramselectdialog.cpp \
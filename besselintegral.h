@@ -0,0 +1,35 @@
+/*
+ * 文件名: besselintegral.h
+ * 文件作用: 零阶修正 Bessel 函数 K0 的解析积分头文件
+ * 功能描述:
+ * 1. 计算 ∫_0^x K0(t) dt (小宗量级数) 与 Bickley 函数 Ki1(x) = ∫_x^∞ K0(t) dt (大宗量 Gauss-Laguerre 求积)。
+ * 2. 两者满足 ∫_0^x K0 + Ki1(x) = π/2，按宗量大小选取无对数奇异、无相消的一侧计算。
+ * 3. 提供裂缝段积分 ∫_lo^hi K0(γ|u|) du，零距离处的对数奇异由解析式精确处理，无需数值积分。
+ * 4. 提供段积分对 γ 与积分限的解析偏导数，供自动微分计算参数灵敏度使用。
+ */
+
+#ifndef BESSELINTEGRAL_H
+#define BESSELINTEGRAL_H
+
+class BesselIntegral
+{
+public:
+    // ∫_0^x K0(t) dt，x >= 0
+    static double k0Integral(double x);
+
+    // Bickley 函数 Ki1(x) = ∫_x^∞ K0(t) dt，x >= 0
+    static double bickleyKi1(double x);
+
+    // ∫_lo^hi K0(gamma * |u|) du，gamma > 0，区间可跨越奇异点 u = 0
+    static double k0SegmentIntegral(double gamma, double lo, double hi);
+
+    // 段积分对 gamma、lo、hi 的偏导数
+    static void k0SegmentIntegralPartials(double gamma, double lo, double hi,
+                                          double& dGamma, double& dLo, double& dHi);
+
+private:
+    static double k0IntegralSeries(double x);
+    static double bickleyKi1Laguerre(double x);
+};
+
+#endif // BESSELINTEGRAL_H
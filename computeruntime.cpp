@@ -0,0 +1,367 @@
+/*
+ * 文件名: computeruntime.cpp
+ * 文件作用: 工作窃取式计算运行时实现
+ * 功能描述:
+ * 1. 每次 parallelFor 用一个计数器记录未完成的下标数，区间任务完成后减去自身长度，计数归零即本层结束。
+ * 2. 窃取从上次成功的位置之后开始轮询各队列，队列长度为零时不加锁。
+ * 3. 等待中的线程只领取本层及其内层 parallelFor 的区间 (沿 parent 链判断)，队列头部不属于本层时向后查找。
+ * 4. body 抛出的异常在区间内捕获并记录在本层的共享状态中，计数照常扣除，由调用线程在本层结束后重新抛出。
+ */
+
+#include "computeruntime.h"
+#include <QThread>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+// 一次 parallelFor 的共享状态 (位于调用线程的栈上，计数归零前不会销毁)
+struct ComputeRuntime::Join {
+    const std::function<void(int)>* body = nullptr;
+    const Join* parent = nullptr;   // 外层 parallelFor (本层在其区间内调用)，顶层为空
+    bool interactive = false;       // 交互区间 (在 InteractiveScope 内或外层为交互区间)
+    int grain = 1;
+    std::atomic<int> remaining{0};
+    std::atomic<bool> failed{false};    // 已有区间抛出异常 (之后开始的区间不再执行 body)
+    std::exception_ptr error;           // 第一个异常，只由置位 failed 的线程写入
+};
+
+// 外部线程登记的队列，线程退出时归还
+struct ComputeRuntime::GuestSlot {
+    ComputeRuntime* runtime = nullptr;
+    int slot = -1;
+    ~GuestSlot() { if (runtime && slot >= 0) runtime->releaseSlot(slot); }
+};
+
+namespace {
+
+thread_local int t_slot = -1;        // 当前线程的队列下标
+thread_local int t_victim = 0;       // 下次窃取的起始位置
+thread_local const void* t_join = nullptr;  // 当前线程正在执行的区间所属的 parallelFor
+thread_local bool t_interactive = false;    // 当前线程处于 InteractiveScope 内
+
+qint64 nowNanos()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+ComputeRuntime* ComputeRuntime::instance()
+{
+    static ComputeRuntime runtime;
+    return &runtime;
+}
+
+ComputeRuntime::ComputeRuntime()
+{
+    startWorkers(QThread::idealThreadCount());
+}
+
+ComputeRuntime::~ComputeRuntime()
+{
+    stopWorkers();
+}
+
+void ComputeRuntime::setWorkerCount(int count)
+{
+    stopWorkers();
+    startWorkers(count);
+}
+
+void ComputeRuntime::startWorkers(int count)
+{
+    count = std::max(1, count);
+    for (int i = 0; i < count; ++i) {
+        int slot = claimSlot();
+        if (slot < 0) break;
+        m_workerSlots.push_back(slot);
+        m_workers.emplace_back([this, slot]() { workerLoop(slot); });
+    }
+}
+
+void ComputeRuntime::stopWorkers()
+{
+    m_stopping = true;
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_epoch.fetch_add(1);
+        m_wake.notify_all();
+    }
+    for (std::thread& worker : m_workers) worker.join();
+    for (int slot : m_workerSlots) releaseSlot(slot);
+    m_workers.clear();
+    m_workerSlots.clear();
+    m_stopping = false;
+}
+
+int ComputeRuntime::claimSlot()
+{
+    for (int i = 0; i < kMaxQueues; ++i) {
+        bool expected = false;
+        if (m_queues[i].claimed.compare_exchange_strong(expected, true)) {
+            int limit = m_slotLimit.load();
+            while (limit < i + 1 && !m_slotLimit.compare_exchange_weak(limit, i + 1)) {}
+            return i;
+        }
+    }
+    return -1;
+}
+
+void ComputeRuntime::releaseSlot(int slot)
+{
+    m_queues[slot].claimed = false;
+}
+
+int ComputeRuntime::currentSlot()
+{
+    if (t_slot >= 0) return t_slot;
+    thread_local GuestSlot guest;
+    if (!guest.runtime) {
+        guest.slot = claimSlot();
+        if (guest.slot < 0) return -1;
+        guest.runtime = this;
+    }
+    t_slot = guest.slot;
+    return t_slot;
+}
+
+ComputeRuntime::InteractiveScope::InteractiveScope()
+    : m_outer(t_interactive)
+{
+    t_interactive = true;
+}
+
+ComputeRuntime::InteractiveScope::~InteractiveScope()
+{
+    t_interactive = m_outer;
+}
+
+void ComputeRuntime::push(int slot, const RangeTask& task)
+{
+    Queue& queue = m_queues[slot];
+    if (task.join->interactive) m_interactiveRanges.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+        queue.size.store(static_cast<int>(queue.tasks.size()), std::memory_order_relaxed);
+    }
+    notifyWork();
+}
+
+bool ComputeRuntime::belongsTo(const RangeTask& task, const Join* scope)
+{
+    if (!scope) return true;
+    // 链上的各层都在等待其内层返回，读取 parent 时不会被销毁
+    for (const Join* join = task.join; join; join = join->parent) {
+        if (join == scope) return true;
+    }
+    return false;
+}
+
+bool ComputeRuntime::popLocal(int slot, RangeTask& task, const Join* scope)
+{
+    Queue& queue = m_queues[slot];
+    if (queue.size.load(std::memory_order_relaxed) == 0) return false;
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    // 本层及内层的区间总是压在外层区间之上，只需检查尾部
+    if (queue.tasks.empty() || !belongsTo(queue.tasks.back(), scope)) return false;
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    queue.size.store(static_cast<int>(queue.tasks.size()), std::memory_order_relaxed);
+    if (task.join->interactive) m_interactiveRanges.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ComputeRuntime::steal(int slot, RangeTask& task, const Join* scope, bool interactiveOnly)
+{
+    const int limit = m_slotLimit.load(std::memory_order_relaxed);
+    for (int k = 0; k < limit; ++k) {
+        int victim = (t_victim + k) % limit;
+        if (victim == slot) continue;
+        Queue& queue = m_queues[victim];
+        if (queue.size.load(std::memory_order_relaxed) == 0) continue;
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        auto it = queue.tasks.begin();
+        while (it != queue.tasks.end()
+               && (!belongsTo(*it, scope) || (interactiveOnly && !it->join->interactive))) ++it;
+        if (it == queue.tasks.end()) continue;
+        task = *it;
+        queue.tasks.erase(it);
+        queue.size.store(static_cast<int>(queue.tasks.size()), std::memory_order_relaxed);
+        if (task.join->interactive) m_interactiveRanges.fetch_sub(1, std::memory_order_relaxed);
+        t_victim = victim;
+        m_queues[slot].steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+bool ComputeRuntime::takeJob(std::function<void()>& job)
+{
+    std::lock_guard<std::mutex> lock(m_jobMutex);
+    if (m_jobs.empty()) return false;
+    job = std::move(m_jobs.front());
+    m_jobs.pop_front();
+    return true;
+}
+
+void ComputeRuntime::notifyWork()
+{
+    m_epoch.fetch_add(1);
+    if (m_sleepers.load() > 0) {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_wake.notify_one();
+    }
+}
+
+void ComputeRuntime::execute(int slot, RangeTask task)
+{
+    Join* join = task.join;
+    while (task.end - task.begin > join->grain) {
+        int mid = task.begin + (task.end - task.begin) / 2;
+        push(slot, RangeTask{join, mid, task.end});
+        task.end = mid;
+    }
+    const void* outer = t_join;
+    t_join = join;
+    if (!join->failed.load(std::memory_order_relaxed)) {
+        try {
+            for (int i = task.begin; i < task.end; ++i) (*join->body)(i);
+        } catch (...) {
+            bool expected = false;
+            if (join->failed.compare_exchange_strong(expected, true)) join->error = std::current_exception();
+        }
+    }
+    t_join = outer;
+    m_queues[slot].executed.fetch_add(1, std::memory_order_relaxed);
+    // 抛出异常的区间同样按全长扣除；计数归零后调用线程可能立即返回并销毁 join，此后不再访问
+    join->remaining.fetch_sub(task.end - task.begin, std::memory_order_acq_rel);
+}
+
+void ComputeRuntime::addIdle(int slot, qint64 idleSince)
+{
+    // 只统计上次清零之后的部分
+    qint64 now = nowNanos();
+    idleSince = std::max(idleSince, m_statsSince.load(std::memory_order_relaxed));
+    if (now > idleSince) m_queues[slot].idleNanos.fetch_add(now - idleSince, std::memory_order_relaxed);
+}
+
+void ComputeRuntime::parallelFor(int count, const std::function<void(int)>& body, int grain)
+{
+    if (count <= 0) return;
+    grain = std::max(1, grain);
+    int slot = (count > grain) ? currentSlot() : -1;
+    if (slot < 0) {
+        for (int i = 0; i < count; ++i) body(i);
+        return;
+    }
+
+    Join join;
+    join.body = &body;
+    join.parent = static_cast<const Join*>(t_join);
+    join.interactive = t_interactive || (join.parent && join.parent->interactive);
+    join.grain = grain;
+    join.remaining.store(count, std::memory_order_relaxed);
+    execute(slot, RangeTask{&join, 0, count});
+
+    // 等待时帮助: 先取回本线程队列中的区间，再窃取其他线程的区间；只执行本层及内层的区间，
+    // 不会在等待栈中压入其他拟合的候选解或个体 (界面预览线程也不会被长任务占住)
+    qint64 idleSince = 0;
+    while (join.remaining.load(std::memory_order_acquire) > 0) {
+        RangeTask task;
+        if (popLocal(slot, task, &join) || steal(slot, task, &join)) {
+            if (idleSince) {
+                addIdle(slot, idleSince);
+                idleSince = 0;
+            }
+            execute(slot, task);
+            continue;
+        }
+        if (!idleSince) idleSince = nowNanos();
+        std::this_thread::yield();
+    }
+    if (idleSince) addIdle(slot, idleSince);
+    if (join.error) std::rethrow_exception(join.error);
+}
+
+void ComputeRuntime::submit(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        m_jobs.push_back(std::move(job));
+    }
+    notifyWork();
+}
+
+void ComputeRuntime::workerLoop(int slot)
+{
+    t_slot = slot;
+    t_victim = slot + 1;
+    qint64 idleSince = 0;
+    int spins = 0;
+    while (!m_stopping.load()) {
+        const unsigned epoch = m_epoch.load();
+        RangeTask task;
+        std::function<void()> job;
+        // 交互区间优先，其次本线程队列、其他线程队列，最后领取新的顶层任务
+        bool isRange = (m_interactiveRanges.load(std::memory_order_relaxed) > 0 && steal(slot, task, nullptr, true))
+                       || popLocal(slot, task, nullptr) || steal(slot, task, nullptr);
+        if (isRange || takeJob(job)) {
+            if (idleSince) {
+                addIdle(slot, idleSince);
+                idleSince = 0;
+            }
+            spins = 0;
+            if (isRange) {
+                execute(slot, task);
+            } else {
+                job();
+                m_queues[slot].jobs.fetch_add(1, std::memory_order_relaxed);
+            }
+            continue;
+        }
+
+        if (!idleSince) idleSince = nowNanos();
+        if (++spins < kSpinRounds) {
+            std::this_thread::yield();
+            continue;
+        }
+        // 休眠到有新任务提交 (计数变化) 或运行时停止
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepers.fetch_add(1);
+        while (m_epoch.load() == epoch && !m_stopping.load()) m_wake.wait(lock);
+        m_sleepers.fetch_sub(1);
+        spins = 0;
+    }
+    if (idleSince) addIdle(slot, idleSince);
+    t_slot = -1;
+}
+
+ComputeRuntime::Stats ComputeRuntime::stats() const
+{
+    Stats s;
+    s.workers = workerCount();
+    const int limit = m_slotLimit.load();
+    qint64 idle = 0;
+    for (int i = 0; i < limit; ++i) {
+        s.tasks += m_queues[i].executed.load(std::memory_order_relaxed);
+        s.steals += m_queues[i].steals.load(std::memory_order_relaxed);
+        s.jobs += m_queues[i].jobs.load(std::memory_order_relaxed);
+        idle += m_queues[i].idleNanos.load(std::memory_order_relaxed);
+    }
+    s.idleSeconds = idle * 1e-9;
+    return s;
+}
+
+void ComputeRuntime::resetStats()
+{
+    m_statsSince = nowNanos();
+    const int limit = m_slotLimit.load();
+    for (int i = 0; i < limit; ++i) {
+        m_queues[i].executed = 0;
+        m_queues[i].steals = 0;
+        m_queues[i].jobs = 0;
+        m_queues[i].idleNanos = 0;
+    }
+}
@@ -0,0 +1,149 @@
+/*
+ * 文件名: computeruntime.h
+ * 文件作用: 工作窃取式计算运行时头文件
+ * 功能描述:
+ * 1. 计算层的各级并行 (拟合 -> 参数扰动 / 种群个体 / 候选解 -> (时间点 x 反演节点) 网格分块)
+ *    统一由同一组工作线程执行，线程数等于 CPU 核数；任意嵌套深度下活动的计算线程数都不超过核数。
+ * 2. 每个线程持有一个双端队列: parallelFor 把下标区间二分，后半段压入本线程队列尾部，自己继续执行前半段；
+ *    本线程从尾部取回 (后进先出，数据仍在缓存中)，空闲线程从其他队列头部窃取 (先进先出，取到的是最大的区间)。
+ * 3. 等待时帮助: parallelFor 在本层全部完成前不阻塞线程，而是继续执行本线程队列中的任务或窃取其他线程的任务。
+ *    等待中的线程只执行本层及其内层 parallelFor 的区间，不领取其他 parallelFor 的区间与新的顶层任务 (拟合)，
+ *    避免无关的长任务 (其他拟合的候选解、种群个体) 压在等待栈中拖慢本层返回。
+ * 4. 非工作线程 (界面线程、预览线程) 调用 parallelFor 时登记一个队列参与计算，其拆分出的区间同样可被窃取；
+ *    按第 3 条，这些线程只帮助自己发起的计算，预览曲线的延迟不受正在运行的拟合影响。
+ * 5. 交互优先: InteractiveScope 期间发起的 parallelFor (含其内层) 为交互区间，空闲的工作线程先领取交互区间，
+ *    再领取本线程队列与其他线程队列中的区间和顶层任务。
+ * 6. 统计: 执行的区间任务数、窃取次数、顶层任务数与空闲时间 (没有任何任务可执行的时间)，用于评估负载均衡与扩展性。
+ */
+
+#ifndef COMPUTERUNTIME_H
+#define COMPUTERUNTIME_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ComputeRuntime
+{
+public:
+    // 运行统计 (各线程计数之和)
+    struct Stats {
+        int workers = 0;            // 工作线程数
+        qint64 tasks = 0;           // 执行的区间任务数
+        qint64 steals = 0;          // 成功窃取的次数
+        qint64 jobs = 0;            // 执行的顶层任务数
+        double idleSeconds = 0.0;   // 没有任务可执行的时间 (含工作线程休眠与等待时的空转)
+    };
+
+    // 进程内唯一的运行时 (首次调用时按 CPU 核数启动工作线程)
+    static ComputeRuntime* instance();
+
+    ~ComputeRuntime();
+
+    int workerCount() const { return static_cast<int>(m_workers.size()); }
+
+    // 以指定线程数重建工作线程 (只能在没有计算任务时调用，用于设置线程数与扩展性测试)
+    void setWorkerCount(int count);
+
+    // 并行执行 body(i)，i = 0 .. count-1；每个区间任务至少包含 grain 个下标
+    // 调用线程参与执行，返回时全部下标已执行完毕；可在 body 内部嵌套调用
+    // body 抛出异常时尚未开始的区间不再执行，本层结束后在调用线程重新抛出第一个异常
+    void parallelFor(int count, const std::function<void(int)>& body, int grain = 1);
+
+    // 提交顶层任务 (拟合)，由空闲的工作线程按提交顺序领取
+    void submit(std::function<void()> job);
+
+    // 交互计算 (界面预览): 对象存在期间当前线程发起的 parallelFor 为交互区间，空闲线程优先领取
+    class InteractiveScope
+    {
+    public:
+        InteractiveScope();
+        ~InteractiveScope();
+    private:
+        bool m_outer;
+    };
+
+    Stats stats() const;
+    void resetStats();
+
+private:
+    struct Join;
+    struct GuestSlot;
+
+    // 区间任务: 某次 parallelFor 的下标区间 [begin, end)
+    struct RangeTask {
+        Join* join = nullptr;
+        int begin = 0;
+        int end = 0;
+    };
+
+    // 线程的双端队列与统计计数 (按缓存行对齐，避免伪共享)
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<RangeTask> tasks;
+        std::atomic<int> size{0};            // 队列长度 (窃取前无锁预判)
+        std::atomic<bool> claimed{false};    // 是否已分配给线程
+        std::atomic<qint64> executed{0};
+        std::atomic<qint64> steals{0};
+        std::atomic<qint64> jobs{0};
+        std::atomic<qint64> idleNanos{0};
+    };
+
+    static constexpr int kMaxQueues = 128;  // 工作线程与登记的外部线程总数上限
+    static constexpr int kSpinRounds = 64;  // 工作线程休眠前的空转轮数
+
+    ComputeRuntime();
+
+    void startWorkers(int count);
+    void stopWorkers();
+    void workerLoop(int slot);
+
+    // 分配 / 释放队列
+    int claimSlot();
+    void releaseSlot(int slot);
+
+    // 当前线程的队列 (工作线程或已登记的外部线程)，队列已用完时返回 -1
+    int currentSlot();
+
+    // 区间是否属于 scope 或其内层 parallelFor (scope 为空时不限制)
+    static bool belongsTo(const RangeTask& task, const Join* scope);
+
+    // 取区间任务: 等待中的线程传入所等待的 parallelFor，空闲的工作线程传入空指针
+    void push(int slot, const RangeTask& task);
+    bool popLocal(int slot, RangeTask& task, const Join* scope);
+    bool steal(int slot, RangeTask& task, const Join* scope, bool interactiveOnly = false);
+    bool takeJob(std::function<void()>& job);
+
+    // 执行区间任务: 二分拆分，后半段压入队列，执行剩余的最小区间
+    void execute(int slot, RangeTask task);
+
+    // 唤醒一个休眠的工作线程
+    void notifyWork();
+
+    // 累加空闲时间 (从 idleSince 到当前)
+    void addIdle(int slot, qint64 idleSince);
+
+    Queue m_queues[kMaxQueues];
+    std::atomic<int> m_slotLimit{0};         // 已分配过的最大队列下标 + 1 (窃取扫描范围)
+    std::atomic<int> m_interactiveRanges{0}; // 队列中的交互区间数 (为零时空闲线程不做优先扫描)
+    std::vector<std::thread> m_workers;
+    std::vector<int> m_workerSlots;
+    std::atomic<bool> m_stopping{false};
+    std::atomic<qint64> m_statsSince{0};     // 统计清零时刻 (纳秒)
+
+    std::mutex m_jobMutex;
+    std::deque<std::function<void()>> m_jobs; // 等待领取的顶层任务
+
+    // 休眠与唤醒: 新任务使计数加一，工作线程在计数不变时才休眠，不会错过唤醒
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<unsigned> m_epoch{0};
+    std::atomic<int> m_sleepers{0};
+};
+
+#endif // COMPUTERUNTIME_H
@@ -0,0 +1,141 @@
+/*
+ * 文件名: differentialevolution.cpp
+ * 文件作用: 差分进化全局优化器实现
+ * 功能描述:
+ * 1. 每代先顺序生成全部试验个体，再作为独立任务交给计算运行时并行计算残差，最后按序号做一对一选择。
+ */
+
+#include "differentialevolution.h"
+#include "multistartfitter.h"
+#include "computeruntime.h"
+
+#include <QVector>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <random>
+
+DifferentialEvolution::DifferentialEvolution(const DifferentialEvolutionOptions& options)
+    : m_options(options)
+{
+}
+
+DifferentialEvolutionResult DifferentialEvolution::minimize(const LeastSquaresProblem& problem, const Eigen::VectorXd& x0,
+                                                            const Eigen::VectorXd& lower, const Eigen::VectorXd& upper,
+                                                            const GenerationCallback& onGeneration) const
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    const int n = x0.size();
+    DifferentialEvolutionResult result;
+    result.x = x0;
+    if (n == 0) return result;
+
+    int populationSize = m_options.populationSize > 0 ? m_options.populationSize : std::min(60, std::max(20, 10 * n));
+    populationSize = std::max(populationSize, 4);   // 变异至少需要 best 之外的两个不同个体
+
+    // 1. 初始种群: 参数表当前值 (投影到搜索盒内) + 拉丁超立方样本
+    QVector<Eigen::VectorXd> population;
+    population.append(x0.cwiseMax(lower).cwiseMin(upper));
+    population += MultiStartFitter::latinHypercube(lower, upper, populationSize - 1, m_options.seed);
+
+    // 并行计算一组个体的残差平方和
+    std::atomic<int> residualCount{0};
+    std::atomic<int> evaluations{0};
+    auto evaluate = [&](const QVector<Eigen::VectorXd>& members, QVector<double>& costs) {
+        costs.fill(inf, members.size());
+        double* costPtr = costs.data();
+        ComputeRuntime::instance()->parallelFor(members.size(), [&](int i) {
+            Eigen::VectorXd r;
+            bool ok = problem.residuals(members[i], r);
+            evaluations++;
+            if (!ok || r.size() == 0) return;
+            residualCount = static_cast<int>(r.size());
+            double sse = r.squaredNorm();
+            if (std::isfinite(sse)) costPtr[i] = sse;
+        });
+    };
+
+    QVector<double> costs;
+    evaluate(population, costs);
+    auto bestIndex = [&]() { return static_cast<int>(std::min_element(costs.begin(), costs.end()) - costs.begin()); };
+    auto mseOf = [&](double sse) { return residualCount > 0 ? sse / residualCount : inf; };
+
+    int best = bestIndex();
+    if (onGeneration && !onGeneration(0, population[best], mseOf(costs[best]))) result.aborted = true;
+
+    // 2. 逐代进化
+    std::mt19937 rng(m_options.seed + 1);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::uniform_int_distribution<int> pickMember(0, populationSize - 1);
+    std::uniform_int_distribution<int> pickDim(0, n - 1);
+    QVector<Eigen::VectorXd> trials(populationSize, Eigen::VectorXd(n));
+    QVector<double> trialCosts;
+
+    int generation = 0;
+    while (!result.aborted && generation < m_options.maxGenerations) {
+        if (mseOf(costs[best]) < m_options.mseTolerance) {
+            result.converged = true;
+            break;
+        }
+
+        // 2.1 变异 + 交叉 (F 每代抖动一次)
+        double F = m_options.minMutation + (m_options.maxMutation - m_options.minMutation) * uniform(rng);
+        for (int i = 0; i < populationSize; ++i) {
+            int r1, r2;
+            do { r1 = pickMember(rng); } while (r1 == i || r1 == best);
+            do { r2 = pickMember(rng); } while (r2 == i || r2 == best || r2 == r1);
+
+            const Eigen::VectorXd& parent = population[i];
+            Eigen::VectorXd& trial = trials[i];
+            int forced = pickDim(rng);   // 至少一维来自变异向量
+            for (int j = 0; j < n; ++j) {
+                if (j != forced && uniform(rng) >= m_options.crossover) {
+                    trial(j) = parent(j);
+                    continue;
+                }
+                double v = population[best](j) + F * (population[r1](j) - population[r2](j));
+                // 越界时在父代与边界之间随机反弹
+                if (v < lower(j)) v = lower(j) + uniform(rng) * (parent(j) - lower(j));
+                else if (v > upper(j)) v = upper(j) - uniform(rng) * (upper(j) - parent(j));
+                trial(j) = v;
+            }
+        }
+
+        // 2.2 并行计算试验个体，一对一选择
+        evaluate(trials, trialCosts);
+        for (int i = 0; i < populationSize; ++i) {
+            if (trialCosts[i] <= costs[i]) {
+                population[i] = trials[i];
+                costs[i] = trialCosts[i];
+            }
+        }
+        best = bestIndex();
+        ++generation;
+
+        if (onGeneration && !onGeneration(generation, population[best], mseOf(costs[best]))) {
+            result.aborted = true;
+            break;
+        }
+
+        // 2.3 种群目标值收敛 (全部个体有限时才判断)
+        double mean = 0.0, var = 0.0;
+        bool finite = true;
+        for (double c : costs) { finite = finite && std::isfinite(c); mean += c; }
+        if (finite) {
+            mean /= populationSize;
+            for (double c : costs) var += (c - mean) * (c - mean);
+            if (std::sqrt(var / populationSize) <= m_options.spreadTolerance * std::abs(mean)) {
+                result.converged = true;
+                break;
+            }
+        }
+    }
+
+    result.x = population[best];
+    result.sse = costs[best];
+    result.mse = mseOf(costs[best]);
+    result.generations = generation;
+    result.evaluations = evaluations;
+    return result;
+}
@@ -0,0 +1,58 @@
+/*
+ * 文件名: differentialevolution.h
+ * 文件作用: 差分进化 (Differential Evolution) 全局优化器头文件
+ * 功能描述:
+ * 1. 目标函数为最小二乘问题的残差平方和 (与 LM 共用 LeastSquaresProblem，只使用残差回调)。
+ * 2. 策略 DE/best/1/bin: 变异 v = x_best + F (x_r1 - x_r2)，F 每代在 [0.5, 1) 内随机抖动，二项交叉。
+ * 3. 越界分量在父代与边界之间随机反弹，种群始终位于搜索盒内。
+ * 4. 初始种群: 参数表当前值 + 拉丁超立方样本；每代的全部试验个体并行计算残差，随机数在主循环中
+ *    顺序生成，结果与线程调度无关。
+ * 5. 结束条件: 最优均方误差低于阈值、种群目标值的离散度足够小、达到最大代数或回调要求中止。
+ */
+
+#ifndef DIFFERENTIALEVOLUTION_H
+#define DIFFERENTIALEVOLUTION_H
+
+#include <functional>
+#include "levenbergmarquardt.h"
+
+struct DifferentialEvolutionOptions {
+    int populationSize = 0;          // 种群规模，0 表示取 10 * 变量数 (限制在 [20, 60])
+    int maxGenerations = 200;        // 最大代数
+    double crossover = 0.9;          // 交叉概率 CR
+    double minMutation = 0.5;        // 变异系数 F 的抖动范围 [minMutation, maxMutation)
+    double maxMutation = 1.0;
+    double mseTolerance = 0.0;       // 最优均方误差低于此值时结束
+    double spreadTolerance = 0.01;   // 种群残差平方和的标准差 <= spreadTolerance * 均值时结束
+    unsigned int seed = 20250519;    // 随机种子
+};
+
+struct DifferentialEvolutionResult {
+    Eigen::VectorXd x;               // 最优个体
+    double sse = 0.0;
+    double mse = 0.0;
+    int generations = 0;
+    int evaluations = 0;             // 残差计算次数
+    bool converged = false;
+    bool aborted = false;
+};
+
+class DifferentialEvolution
+{
+public:
+    // 每代结束后调用 (代数, 最优个体, 最优均方误差)，返回 false 时中止
+    using GenerationCallback = std::function<bool(int generation, const Eigen::VectorXd& best, double mse)>;
+
+    explicit DifferentialEvolution(const DifferentialEvolutionOptions& options = DifferentialEvolutionOptions());
+
+    // 在 [lower, upper] 内搜索 (应位于 problem 的盒约束之内)；problem.residuals 须可并发调用，
+    // 返回 false 的个体视为目标值无穷大
+    DifferentialEvolutionResult minimize(const LeastSquaresProblem& problem, const Eigen::VectorXd& x0,
+                                         const Eigen::VectorXd& lower, const Eigen::VectorXd& upper,
+                                         const GenerationCallback& onGeneration = GenerationCallback()) const;
+
+private:
+    DifferentialEvolutionOptions m_options;
+};
+
+#endif // DIFFERENTIALEVOLUTION_H
@@ -0,0 +1,126 @@
+/*
+ * 文件名: dimensionlesscurvecache.cpp
+ * 文件作用: 无因次曲线缓存实现
+ * 功能描述:
+ * 1. 形状参数按位比较: 只有比例参数变化时形状参数逐位相同，任何形状变化都视为新曲线。
+ * 2. 插值方式与插值模式的直接计算路径一致；粗网格取在固定的对数格点上，命中缓存与重新反演得到的曲线在共同范围内
+ *    网格相同 (只在两端细化不同的区间有插值差别)。
+ */
+
+#include "dimensionlesscurvecache.h"
+#include <QMutexLocker>
+#include <cmath>
+#include <cstring>
+
+DimensionlessCurveKey DimensionlessCurveKey::fromParams(const ModelParamVector& params, int nodes, int pointsPerDecade)
+{
+    DimensionlessCurveKey key;
+    const double km = params[Param_km];
+    key.shape[0] = std::abs(km) > 0.0 ? params[Param_kf] / km : 0.0;
+    key.shape[1] = params[Param_LfD];
+    key.shape[2] = params[Param_nf];
+    key.shape[3] = params[Param_rmD];
+    key.shape[4] = params[Param_reD];
+    key.shape[5] = params[Param_omega1];
+    key.shape[6] = params[Param_omega2];
+    key.shape[7] = params[Param_lambda1];
+    key.shape[8] = params[Param_gamaD];
+    key.shape[9] = params[Param_cD];
+    key.shape[10] = params[Param_S];
+    key.nodes = nodes;
+    key.pointsPerDecade = pointsPerDecade;
+    return key;
+}
+
+bool DimensionlessCurveKey::operator==(const DimensionlessCurveKey& other) const
+{
+    return nodes == other.nodes && pointsPerDecade == other.pointsPerDecade
+           && std::memcmp(shape, other.shape, sizeof(shape)) == 0;
+}
+
+namespace {
+
+// 插值坐标: 全部为正时取对数
+QVector<double> interpolationValues(const QVector<double>& gridPD, bool logPressure)
+{
+    QVector<double> ys(gridPD.size());
+    for (int i = 0; i < gridPD.size(); ++i) ys[i] = logPressure ? std::log(gridPD[i]) : gridPD[i];
+    return ys;
+}
+
+QVector<double> logValues(const QVector<double>& gridT)
+{
+    QVector<double> logT(gridT.size());
+    for (int i = 0; i < gridT.size(); ++i) logT[i] = std::log(gridT[i]);
+    return logT;
+}
+
+bool allPositive(const QVector<double>& values)
+{
+    for (double v : values) if (v <= 0.0) return false;
+    return true;
+}
+
+} // namespace
+
+DimensionlessCurve::DimensionlessCurve(const QVector<double>& gridT, const QVector<double>& gridPD)
+    : m_gridT(gridT), m_logPressure(allPositive(gridPD)),
+      m_interp(logValues(gridT), interpolationValues(gridPD, allPositive(gridPD)))
+{
+}
+
+bool DimensionlessCurve::covers(double tMin, double tMax) const
+{
+    return tMin >= m_gridT.first() && tMax <= m_gridT.last();
+}
+
+double DimensionlessCurve::evaluate(double tD) const
+{
+    double v = m_interp.evaluate(std::log(tD));
+    return m_logPressure ? std::exp(v) : v;
+}
+
+QVector<DualNumber> DimensionlessCurve::evaluate(const QVector<DualNumber>& gridPD, const QVector<DualNumber>& tD) const
+{
+    QVector<DualNumber> ys(gridPD.size());
+    for (int i = 0; i < gridPD.size(); ++i) ys[i] = m_logPressure ? log(gridPD[i]) : gridPD[i];
+    MonotoneCubicInterpolator<DualNumber> interp(logValues(m_gridT), ys);
+
+    QVector<DualNumber> out(tD.size(), DualNumber(0.0));
+    for (int k = 0; k < tD.size(); ++k) {
+        if (tD[k].v <= 1e-12) continue;
+        DualNumber v = interp.evaluate(log(tD[k]));
+        out[k] = m_logPressure ? exp(v) : v;
+    }
+    return out;
+}
+
+DimensionlessCurveCache::DimensionlessCurveCache(int capacity)
+    : m_capacity(capacity)
+{
+}
+
+std::shared_ptr<const DimensionlessCurve> DimensionlessCurveCache::find(const DimensionlessCurveKey& key) const
+{
+    QMutexLocker locker(&m_mutex);
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].key == key) {
+            if (i > 0) m_entries.move(i, 0);
+            return m_entries.first().curve;
+        }
+    }
+    return nullptr;
+}
+
+void DimensionlessCurveCache::insert(const DimensionlessCurveKey& key, const std::shared_ptr<const DimensionlessCurve>& curve)
+{
+    QMutexLocker locker(&m_mutex);
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].key == key) {
+            m_entries.removeAt(i);
+            break;
+        }
+    }
+    m_entries.prepend(Entry{key, curve});
+    while (m_entries.size() > m_capacity) m_entries.removeLast();
+}
@@ -0,0 +1,85 @@
+/*
+ * 文件名: dimensionlesscurvecache.h
+ * 文件作用: 无因次曲线缓存头文件
+ * 功能描述:
+ * 1. phi、mu、Ct、q、h、B 只通过无因次时间 tD = 14.4 kf t / (phi mu Ct L^2) 与压力系数 1.842e-3 q mu B / (kf h)
+ *    进入理论曲线，在双对数坐标中只使曲线平移；无因次曲线 pD(tD) 只由形状参数 (kf/km、LfD、nf、rmD、reD、
+ *    omega1、omega2、lambda1、gamaD、cD、S) 与反演设置决定。
+ * 2. 插值模式把粗网格上的 pD(tD) 按形状参数缓存: 形状不变、只有比例参数变化时直接在缓存曲线上插值，
+ *    不做 Laplace 反演 (kf、L 单独变化会改变 kf/km、LfD，按新形状重新计算)。
+ * 3. 缓存保留最近使用的若干条曲线，查找与插入由互斥锁保护，曲线本身创建后只读，可在多个线程中共享。
+ * 4. 灵敏度计算在同一曲线的网格上以同一插值方式插值 DualNumber 值，得到的导数就是残差所用插值曲线的导数。
+ */
+
+#ifndef DIMENSIONLESSCURVECACHE_H
+#define DIMENSIONLESSCURVECACHE_H
+
+#include <QList>
+#include <QMutex>
+#include <QVector>
+#include <memory>
+#include "modelparamvector.h"
+#include "monotonecubic.h"
+#include "dualnumber.h"
+
+// 缓存键: 形状参数与反演设置
+struct DimensionlessCurveKey {
+    static const int kShapeCount = 11;
+
+    double shape[kShapeCount];   // kf/km, LfD, nf, rmD, reD, omega1, omega2, lambda1, gamaD, cD, S
+    int nodes = 0;               // 反演节点数
+    int pointsPerDecade = 0;     // 粗网格每个对数周期的初始点数
+
+    static DimensionlessCurveKey fromParams(const ModelParamVector& params, int nodes, int pointsPerDecade);
+
+    bool operator==(const DimensionlessCurveKey& other) const;
+};
+
+// 粗网格上的无因次曲线 pD(tD) 及其插值器 (全部为正时在双对数坐标插值，否则在半对数坐标插值)
+class DimensionlessCurve
+{
+public:
+    // gridT 严格递增且至少 2 个点
+    DimensionlessCurve(const QVector<double>& gridT, const QVector<double>& gridPD);
+
+    double tMin() const { return m_gridT.first(); }
+    double tMax() const { return m_gridT.last(); }
+    const QVector<double>& gridT() const { return m_gridT; }
+
+    // 缓存范围是否覆盖 [tMin, tMax]
+    bool covers(double tMin, double tMax) const;
+
+    double evaluate(double tD) const;
+
+    // 与 evaluate 相同的插值: gridPD 为本网格各点的 DualNumber 值，tD 可携带导数；不大于 1e-12 的时间点结果为 0
+    QVector<DualNumber> evaluate(const QVector<DualNumber>& gridPD, const QVector<DualNumber>& tD) const;
+
+private:
+    QVector<double> m_gridT;
+    bool m_logPressure;
+    MonotoneCubicInterpolator<double> m_interp;
+};
+
+class DimensionlessCurveCache
+{
+public:
+    explicit DimensionlessCurveCache(int capacity = 16);
+
+    // 查找形状相同的曲线 (不检查时间范围)，未找到返回空指针
+    std::shared_ptr<const DimensionlessCurve> find(const DimensionlessCurveKey& key) const;
+
+    // 插入或替换形状相同的曲线，超出容量时淘汰最久未使用的曲线
+    void insert(const DimensionlessCurveKey& key, const std::shared_ptr<const DimensionlessCurve>& curve);
+
+private:
+    struct Entry {
+        DimensionlessCurveKey key;
+        std::shared_ptr<const DimensionlessCurve> curve;
+    };
+
+    int m_capacity;
+    mutable QMutex m_mutex;
+    mutable QList<Entry> m_entries;   // 按最近使用排序 (最新在前)
+};
+
+#endif // DIMENSIONLESSCURVECACHE_H
@@ -0,0 +1,108 @@
+/*
+ * 文件名: dualnumber.h
+ * 文件作用: 前向模式自动微分的对偶数类型
+ * 功能描述:
+ * 1. DualNumber 同时携带函数值与对若干方向 (待求导参数) 的一阶导数，四则运算与初等函数
+ *    按链式法则逐方向传播导数，一次计算即得到函数值及其对全部参数的偏导数。
+ * 2. 方向数 n 为运行期值 (不超过 kMaxDirections)；n = 0 表示与参数无关的常数，
+ *    常数参与的运算不做导数循环。同一次计算中所有非常数对偶数的方向数相同。
+ * 3. 比较运算只比较函数值，因此模板化的计算代码与 double 版本走相同的分支。
+ */
+
+#ifndef DUALNUMBER_H
+#define DUALNUMBER_H
+
+#include <cmath>
+
+struct DualNumber
+{
+    static const int kMaxDirections = 16;
+
+    double v;                   // 函数值
+    int n;                      // 导数方向数 (0 表示常数)
+    double d[kMaxDirections];   // 各方向的导数
+
+    DualNumber(double value = 0.0) : v(value), n(0) {}
+
+    explicit operator double() const { return v; }
+
+    // 自变量: 共 directions 个方向，第 dir 个方向的导数为 1，其余为 0
+    static DualNumber variable(double value, int directions, int dir)
+    {
+        DualNumber r(value);
+        r.n = directions;
+        for (int i = 0; i < directions; ++i) r.d[i] = 0.0;
+        r.d[dir] = 1.0;
+        return r;
+    }
+
+    // 一元复合 g(a): 函数值 value，导数 da * a'
+    static DualNumber chain(double value, const DualNumber& a, double da)
+    {
+        DualNumber r(value);
+        r.n = a.n;
+        for (int i = 0; i < a.n; ++i) r.d[i] = da * a.d[i];
+        return r;
+    }
+
+    // 二元复合 g(a, b): 函数值 value，导数 da * a' + db * b'
+    static DualNumber chain(double value, const DualNumber& a, double da, const DualNumber& b, double db)
+    {
+        if (a.n == 0) return chain(value, b, db);
+        if (b.n == 0) return chain(value, a, da);
+        DualNumber r(value);
+        r.n = a.n;
+        for (int i = 0; i < a.n; ++i) r.d[i] = da * a.d[i] + db * b.d[i];
+        return r;
+    }
+
+    // 第 i 个方向的导数 (常数返回 0)
+    double derivative(int i) const { return i < n ? d[i] : 0.0; }
+
+    DualNumber& operator+=(const DualNumber& b);
+    DualNumber& operator-=(const DualNumber& b);
+    DualNumber& operator*=(const DualNumber& b);
+    DualNumber& operator/=(const DualNumber& b);
+};
+
+inline DualNumber operator+(const DualNumber& a, const DualNumber& b) { return DualNumber::chain(a.v + b.v, a, 1.0, b, 1.0); }
+inline DualNumber operator-(const DualNumber& a, const DualNumber& b) { return DualNumber::chain(a.v - b.v, a, 1.0, b, -1.0); }
+inline DualNumber operator*(const DualNumber& a, const DualNumber& b) { return DualNumber::chain(a.v * b.v, a, b.v, b, a.v); }
+inline DualNumber operator/(const DualNumber& a, const DualNumber& b)
+{
+    double r = a.v / b.v;
+    return DualNumber::chain(r, a, 1.0 / b.v, b, -r / b.v);
+}
+inline DualNumber operator-(const DualNumber& a) { return DualNumber::chain(-a.v, a, -1.0); }
+
+inline DualNumber& DualNumber::operator+=(const DualNumber& b) { return *this = *this + b; }
+inline DualNumber& DualNumber::operator-=(const DualNumber& b) { return *this = *this - b; }
+inline DualNumber& DualNumber::operator*=(const DualNumber& b) { return *this = *this * b; }
+inline DualNumber& DualNumber::operator/=(const DualNumber& b) { return *this = *this / b; }
+
+inline bool operator<(const DualNumber& a, const DualNumber& b) { return a.v < b.v; }
+inline bool operator>(const DualNumber& a, const DualNumber& b) { return a.v > b.v; }
+inline bool operator<=(const DualNumber& a, const DualNumber& b) { return a.v <= b.v; }
+inline bool operator>=(const DualNumber& a, const DualNumber& b) { return a.v >= b.v; }
+inline bool operator==(const DualNumber& a, const DualNumber& b) { return a.v == b.v; }
+inline bool operator!=(const DualNumber& a, const DualNumber& b) { return a.v != b.v; }
+
+// 初等函数 (模板代码中以 using std::xxx 后的非限定调用同时匹配 double 与 DualNumber)
+inline DualNumber sqrt(const DualNumber& a)
+{
+    double r = std::sqrt(a.v);
+    return DualNumber::chain(r, a, 0.5 / r);
+}
+inline DualNumber exp(const DualNumber& a)
+{
+    double r = std::exp(a.v);
+    return DualNumber::chain(r, a, r);
+}
+inline DualNumber log(const DualNumber& a) { return DualNumber::chain(std::log(a.v), a, 1.0 / a.v); }
+inline DualNumber abs(const DualNumber& a) { return a.v < 0.0 ? -a : a; }
+
+// 取函数值
+inline double dualValue(double x) { return x; }
+inline double dualValue(const DualNumber& x) { return x.v; }
+
+#endif // DUALNUMBER_H
@@ -0,0 +1,743 @@
+/*
+ * 文件名: fitjob.cpp
+ * 文件作用: 拟合任务实现
+ * 功能描述:
+ * 1. 拟合变量、最小二乘问题 (残差 / 雅可比) 与三种优化流程 (LM、多起点全局拟合、差分进化) 的实现，
+ *    只读取任务创建时的数据快照。
+ * 2. 结束时在全分辨率数据上计算最终误差，并以高精度设置计算最终曲线，随结果一起报告。
+ * 3. 变量投影的试探点 (LM 未知量) 与求解出的完整拟合变量按最近使用记录，残差、雅可比与进度回调
+ *    对同一试探点只求解一次平移量。
+ */
+
+#include "fitjob.h"
+#include "computeruntime.h"
+#include <QMutexLocker>
+#include <cmath>
+#include <limits>
+
+// 变量投影中最近求解的试探点 (LM 未知量 -> 完整拟合变量与残差)
+struct FitJob::ShiftMemory {
+    struct Entry {
+        Eigen::VectorXd xFree;
+        Eigen::VectorXd x;
+        Eigen::VectorXd r;
+    };
+    static const int kCapacity = 8;
+
+    QMutex mutex;
+    QList<Entry> entries;                 // 最新在前
+    std::atomic<int> evaluations{0};      // 时间平移搜索的残差计算次数
+
+    bool find(const Eigen::VectorXd& xFree, Eigen::VectorXd& x, Eigen::VectorXd& r)
+    {
+        QMutexLocker locker(&mutex);
+        for(const Entry& e : entries) {
+            if(e.xFree.size() == xFree.size() && e.xFree == xFree) {
+                x = e.x;
+                r = e.r;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void store(const Eigen::VectorXd& xFree, const Eigen::VectorXd& x, const Eigen::VectorXd& r)
+    {
+        QMutexLocker locker(&mutex);
+        entries.prepend(Entry{xFree, x, r});
+        while(entries.size() > kCapacity) entries.removeLast();
+    }
+
+    // 最近一次求解的完整拟合变量 (平移量作为下一次求解的初值)，尚未求解时返回 fallback
+    Eigen::VectorXd latest(const Eigen::VectorXd& fallback)
+    {
+        QMutexLocker locker(&mutex);
+        return entries.isEmpty() ? fallback : entries.first().x;
+    }
+};
+
+FitJob::FitJob(ModelManager* modelManager, const FitJobSettings& settings)
+    : m_modelManager(modelManager), m_settings(settings)
+{
+    m_future = m_promise.future();
+}
+
+/**
+ * @brief 拟合入口 (由调度器在工作线程上调用，只调用一次)
+ * 已被取消的任务 (排队时撤销) 不运行优化，直接结束 future。
+ */
+void FitJob::execute()
+{
+    m_promise.start();
+    if(!m_promise.isCanceled()) run();
+    m_promise.finish();
+}
+
+void FitJob::requestStop()
+{
+    m_stop = true;
+}
+
+void FitJob::cancel()
+{
+    m_stop = true;
+    m_future.cancel();
+}
+
+/**
+ * @brief 拟合线程入口: 选择优化流程，结束后计算最终误差与曲线并报告结果
+ */
+void FitJob::run()
+{
+    m_promise.setProgressRange(0, 100);
+
+    FitJobResult result;
+    result.variables = FitVariables::fromParameters(m_settings.params);
+    const FitVariables& vars = result.variables;
+
+    // 没有勾选任何拟合参数或没有拟合数据时直接结束
+    ModelParamVector params = vars.base;
+    double iterationMSE = 0.0;
+    if(!vars.fitIds.isEmpty() && !m_settings.fitData.isEmpty()) {
+        if(m_settings.global) runMultiStart(vars, result, params, iterationMSE);
+        else if(m_settings.optimizer == Optimizer_DifferentialEvolution) runDifferentialEvolution(vars, result, params, iterationMSE);
+        else runLevenbergMarquardt(vars, result, params, iterationMSE);
+    }
+    result.stopped = stopRequested();
+
+    // 已取消: 不再计算最终曲线 (QFuture 已处于取消状态，结果不会被接收)
+    if(m_promise.isCanceled()) return;
+
+    // 最终误差在全分辨率观测数据上以高精度设置计算 (未抽稀时直接使用迭代误差)，最终曲线同样使用高精度设置
+    if(result.valid) {
+        result.params = params;
+        result.mse = iterationMSE;
+        if(!m_settings.fullData.isEmpty()) {
+            ModelSolverOptions fullOptions;
+            fullOptions.interpolate = true;
+            QVector<double> fullRes = calculateResiduals(params, m_settings.fullData, fullOptions);
+            if(!fullRes.isEmpty()) result.mse = calculateSumSquaredError(fullRes) / fullRes.size();
+        }
+        result.curve = m_modelManager->calculateTheoreticalCurve(m_settings.modelType, params);
+    }
+
+    m_promise.addResult(result);
+}
+
+/**
+ * @brief 报告进度并发布当前参数
+ * QFuture 被取消时同时置位停止标志，使模型节点循环和雅可比任务尽快结束。
+ */
+bool FitJob::reportProgress(int progress, const ModelParamVector& params, double mse)
+{
+    m_promise.setProgressValue(progress);
+    if(m_promise.isCanceled()) m_stop = true;
+    FitProgressSnapshot snapshot;
+    snapshot.params = params;
+    snapshot.mse = mse;
+    m_progress.publish(snapshot);
+    return !stopRequested();
+}
+
+/**
+ * @brief Levenberg-Marquardt 拟合: 信赖域 LM 求解器，初始点及每次接受步长后报告进度
+ */
+void FitJob::runLevenbergMarquardt(const FitVariables& vars, FitJobResult& result, ModelParamVector& params, double& iterationMSE)
+{
+    LevenbergMarquardtOptions lmOptions;
+    lmOptions.maxIterations = 100;
+    lmOptions.mseTolerance = 3e-3;  // 均方误差足够小时提前结束
+    lmOptions.broydenUpdate = m_settings.broydenUpdate;
+
+    auto onStep = [&](int iteration, const Eigen::VectorXd& x, double mse) {
+        return reportProgress(iteration * 100 / lmOptions.maxIterations, vars.toParams(x), mse);
+    };
+
+    LevenbergMarquardtResult lm = solveLevenbergMarquardt(vars, lmOptions, vars.x0, result.stats, onStep);
+    result.stats.iterations = lm.iterations;
+    result.stats.jacobianEvaluations = lm.jacobianEvaluations;
+    result.stats.broydenUpdates = lm.broydenUpdates;
+    result.stats.residualEvaluations = lm.residualEvaluations;
+
+    params = vars.toParams(lm.x.size() == vars.x0.size() ? lm.x : vars.x0);
+    iterationMSE = lm.residuals.size() == 0 ? 0.0 : lm.sse / lm.residuals.size();
+    result.valid = true;
+}
+
+/**
+ * @brief 多起点全局拟合
+ * 参数表当前值与拉丁超立方起点 (log10 域均匀分层) 上并行运行截断 LM，每轮淘汰落后于当前最优的候选，
+ * 幸存者运行到收敛；每轮结束后发布当前最优解，全部候选随结果报告供结果列表选择。
+ */
+void FitJob::runMultiStart(const FitVariables& vars, FitJobResult& result, ModelParamVector& params, double& iterationMSE)
+{
+    LeastSquaresProblem problem = makeFitProblem(vars);
+
+    // 全局拟合中各候选运行到收敛 (不按误差阈值提前结束)，以便比较不同的极小值
+    MultiStartOptions msOptions;
+    msOptions.starts = m_settings.globalStarts;
+    msOptions.lm.maxIterations = 100;
+    msOptions.lm.broydenUpdate = m_settings.broydenUpdate;
+
+    auto onStage = [&](int stage, double progress, const MultiStartCandidate& best) {
+        Q_UNUSED(stage);
+        return reportProgress(static_cast<int>(progress * 100), vars.toParams(best.x), best.mse);
+    };
+
+    result.candidates = MultiStartFitter(msOptions).run(problem, vars.x0, vars.sampleLower, vars.sampleUpper, onStage);
+    for(const MultiStartCandidate& c : result.candidates) {
+        result.stats.iterations += c.iterations;
+        result.stats.jacobianEvaluations += c.jacobianEvaluations;
+        result.stats.residualEvaluations += c.residualEvaluations;
+    }
+
+    // 界面先显示误差最小的解，结果列表中可改选其他候选
+    if(!result.candidates.isEmpty()) {
+        params = vars.toParams(result.candidates.first().x);
+        iterationMSE = result.candidates.first().mse;
+        result.valid = true;
+    }
+}
+
+/**
+ * @brief 差分进化拟合
+ * 在拟合变量的起点采样范围 (log10 域) 内进化种群，每代的个体并行计算残差，每代结束后发布当前最优个体。
+ * 勾选 LM 精修时从最优个体出发运行 LM，以得到局部极小值的精确位置。
+ */
+void FitJob::runDifferentialEvolution(const FitVariables& vars, FitJobResult& result, ModelParamVector& params, double& iterationMSE)
+{
+    LeastSquaresProblem problem = makeFitProblem(vars);
+
+    // 1. 差分进化 (均方误差足够小时提前结束；精修时进度条前 80% 属于进化阶段)
+    DifferentialEvolutionOptions deOptions;
+    deOptions.mseTolerance = 3e-3;
+    const int deProgress = m_settings.polishWithLM ? 80 : 100;
+
+    auto onGeneration = [&](int generation, const Eigen::VectorXd& best, double mse) {
+        return reportProgress(generation * deProgress / deOptions.maxGenerations, vars.toParams(best), mse);
+    };
+
+    DifferentialEvolutionResult de = DifferentialEvolution(deOptions).minimize(problem, vars.x0, vars.sampleLower, vars.sampleUpper, onGeneration);
+    result.stats.generations = de.generations;
+    result.stats.residualEvaluations = de.evaluations;
+    Eigen::VectorXd x = de.x;
+    double mse = de.mse;
+
+    // 2. LM 精修 (运行到收敛，不按误差阈值提前结束)
+    if(m_settings.polishWithLM && !de.aborted && !stopRequested()) {
+        LevenbergMarquardtOptions lmOptions;
+        lmOptions.maxIterations = 100;
+        lmOptions.broydenUpdate = m_settings.broydenUpdate;
+
+        auto onStep = [&](int iteration, const Eigen::VectorXd& xStep, double stepMSE) {
+            return reportProgress(deProgress + iteration * (100 - deProgress) / lmOptions.maxIterations, vars.toParams(xStep), stepMSE);
+        };
+
+        LevenbergMarquardtResult lm = solveLevenbergMarquardt(vars, lmOptions, x, result.stats, onStep);
+        result.stats.iterations = lm.iterations;
+        result.stats.jacobianEvaluations = lm.jacobianEvaluations;
+        result.stats.broydenUpdates = lm.broydenUpdates;
+        result.stats.residualEvaluations += lm.residualEvaluations;
+        if(lm.x.size() == x.size() && lm.residuals.size() > 0) {
+            x = lm.x;
+            mse = lm.sse / lm.residuals.size();
+        }
+    }
+
+    params = vars.toParams(x);
+    iterationMSE = mse;
+    result.valid = true;
+}
+
+/**
+ * @brief 运行 LM 迭代
+ * 未勾选变量投影或没有可消去的平移参数时直接求解拟合变量；否则以其余拟合变量为未知量，
+ * 平移量在每个试探点内部求解，结束时换算回完整的拟合变量。
+ */
+LevenbergMarquardtResult FitJob::solveLevenbergMarquardt(const FitVariables& vars, const LevenbergMarquardtOptions& options,
+                                                         const Eigen::VectorXd& x0, FitIterationStats& stats,
+                                                         const std::function<bool(int, const Eigen::VectorXd&, double)>& onStep)
+{
+    ShiftProjection projection;
+    if(m_settings.variableProjection) projection = ShiftProjection::fromVariables(vars, m_settings.projectTimeShift);
+
+    // 残差在抽稀数据上以迭代精度计算，收到停止请求时中止
+    if(!projection.active()) {
+        auto step = [&](int iteration, const Eigen::VectorXd& x, const Eigen::VectorXd& r) {
+            return onStep(iteration, x, r.squaredNorm() / r.size());
+        };
+        return LevenbergMarquardtSolver(options).solve(makeFitProblem(vars), x0, step);
+    }
+
+    auto memory = std::make_shared<ShiftMemory>();
+    // LM 未知量 -> 完整拟合变量 (已求解的试探点取记录的平移量，否则沿用最近一次的平移量)
+    auto expand = [&](const Eigen::VectorXd& xFree) {
+        Eigen::VectorXd x, r;
+        if(memory->find(xFree, x, r)) return x;
+        x = memory->latest(x0);
+        if(xFree.size() == projection.freeVars.size()) {
+            for(int k = 0; k < projection.freeVars.size(); ++k) x(projection.freeVars[k]) = xFree(k);
+        }
+        return x;
+    };
+    auto step = [&](int iteration, const Eigen::VectorXd& xFree, const Eigen::VectorXd& r) {
+        return onStep(iteration, expand(xFree), r.squaredNorm() / r.size());
+    };
+
+    LevenbergMarquardtResult lm = LevenbergMarquardtSolver(options).solve(makeProjectedProblem(vars, projection, memory),
+                                                                          projection.reduce(x0), step);
+    lm.x = expand(lm.x);
+    stats.shiftEvaluations += memory->evaluations.load();
+    return lm;
+}
+
+/**
+ * @brief 构造变量投影的最小二乘问题
+ * 残差为平移量取最优值时的残差；雅可比矩阵按 Kaufman 近似取完整雅可比矩阵中其余参数的列，
+ * 减去其在平移参数列 (取值未落在边界上的) 张成的子空间上的投影。
+ */
+LeastSquaresProblem FitJob::makeProjectedProblem(const FitVariables& vars, const ShiftProjection& projection,
+                                                 const std::shared_ptr<ShiftMemory>& memory)
+{
+    // 求解试探点的平移量 (同一试探点只求解一次)
+    auto solve = [this, vars, projection, memory](const Eigen::VectorXd& xFree, Eigen::VectorXd& x, Eigen::VectorXd& r) {
+        if(memory->find(xFree, x, r)) return true;
+        x = memory->latest(vars.x0);
+        for(int k = 0; k < projection.freeVars.size(); ++k) x(projection.freeVars[k]) = xFree(k);
+        int evaluations = 0;
+        bool ok = solveShifts(vars, projection, x, r, evaluations);
+        memory->evaluations += evaluations;
+        if(!ok || stopRequested()) return false;
+        memory->store(xFree, x, r);
+        return true;
+    };
+
+    LeastSquaresProblem problem;
+    problem.lower = projection.reduce(vars.lower);
+    problem.upper = projection.reduce(vars.upper);
+    problem.residuals = [this, solve](const Eigen::VectorXd& xFree, Eigen::VectorXd& r) {
+        if(stopRequested()) return false;
+        Eigen::VectorXd x;
+        return solve(xFree, x, r);
+    };
+    problem.jacobian = [this, vars, projection, solve](const Eigen::VectorXd& xFree, const Eigen::VectorXd& r, Eigen::MatrixXd& J) {
+        if(stopRequested()) return false;
+        Eigen::VectorXd x, rFull;
+        if(!solve(xFree, x, rFull)) return false;
+        Eigen::MatrixXd full;
+        if(!computeJacobian(vars.toParams(x), r.size(), vars.fitIds, vars.logScale, full)) return false;
+
+        J.resize(full.rows(), projection.freeVars.size());
+        for(int k = 0; k < projection.freeVars.size(); ++k) J.col(k) = full.col(projection.freeVars[k]);
+
+        // 落在边界上的平移量不再随其余参数变化，不参与投影
+        QVector<int> shiftVars;
+        for(int v : {projection.pressureVar, projection.timeVar}) {
+            if(v >= 0 && x(v) > vars.lower(v) && x(v) < vars.upper(v)) shiftVars.append(v);
+        }
+        if(shiftVars.isEmpty() || J.cols() == 0) return true;
+        Eigen::MatrixXd E(full.rows(), shiftVars.size());
+        for(int k = 0; k < shiftVars.size(); ++k) E.col(k) = full.col(shiftVars[k]);
+        if(!E.allFinite()) E = E.unaryExpr([](double v) { return std::isfinite(v) ? v : 0.0; });
+        J -= E * E.colPivHouseholderQr().solve(J);
+        return true;
+    };
+    return problem;
+}
+
+/**
+ * @brief 求解平移参数
+ * 压力平移: 残差 r(c) = r0 + c w (w 为残差对 ln F 的偏导数)，最优 c = -(w·r0)/(w·w)，换算到参数后按参数范围截断。
+ * 时间平移: 在采样范围内按 0.25 个对数周期粗扫 (先算两端，使缓存的无因次曲线一次覆盖整个范围，
+ * 其余试探点只在缓存曲线上插值)，再在最优格点两侧黄金分割；每个时间平移的试探点都闭式求解压力平移。
+ */
+bool FitJob::solveShifts(const FitVariables& vars, const ShiftProjection& projection, Eigen::VectorXd& x, Eigen::VectorXd& r,
+                         int& evaluations) const
+{
+    const double kScanStep = 0.25;     // 粗扫步长 (log10)
+    const double kTolerance = 1e-4;    // 黄金分割区间长度 (log10)
+    const double ln10 = std::log(10.0);
+    const ModelSolverOptions options = iterationOptions();
+
+    auto evaluate = [&](Eigen::VectorXd& xt, Eigen::VectorXd& rt) {
+        QVector<double> w;
+        QVector<double> res = calculateResiduals(vars.toParams(xt), m_settings.fitData, options, &w);
+        if(res.isEmpty() || stopRequested()) return false;
+        rt = Eigen::Map<const Eigen::VectorXd>(res.constData(), res.size());
+        int k = projection.pressureVar;
+        if(k < 0 || w.size() != res.size()) return true;
+        Eigen::Map<const Eigen::VectorXd> wv(w.constData(), w.size());
+        double ww = wv.squaredNorm();
+        if(ww <= 0.0) return true;
+        // F 与 q、B 成正比，与 h 成反比: ln F 增加 c 对应 log10 θ 增加 sign * c / ln10
+        double sign = vars.fitIds[k] == Param_h ? -1.0 : 1.0;
+        double c = -wv.dot(rt) / ww;
+        double target = qBound(vars.lower(k), xt(k) + sign * c / ln10, vars.upper(k));
+        rt += (sign * (target - xt(k)) * ln10) * wv;
+        xt(k) = target;
+        return true;
+    };
+
+    const int t = projection.timeVar;
+    if(t < 0) return evaluate(x, r);
+
+    double bestSSE = std::numeric_limits<double>::infinity();
+    Eigen::VectorXd bestX = x, bestR;
+    Eigen::VectorXd xt, rt;
+    auto trial = [&](double value, double& sse) {
+        xt = x;
+        xt(t) = value;
+        ++evaluations;
+        if(!evaluate(xt, rt)) return false;
+        sse = rt.squaredNorm();
+        if(!std::isfinite(sse)) sse = std::numeric_limits<double>::infinity();
+        if(sse < bestSSE) {
+            bestSSE = sse;
+            bestX = xt;
+            bestR = rt;
+        }
+        return true;
+    };
+
+    // 1. 粗扫
+    double lo = qMax(vars.lower(t), vars.sampleLower(t));
+    double hi = qMin(vars.upper(t), vars.sampleUpper(t));
+    if(!(hi > lo)) lo = hi = qBound(vars.lower(t), x(t), vars.upper(t));
+    int n = hi > lo ? qMax(2, (int)std::ceil((hi - lo) / kScanStep) + 1) : 1;
+    QVector<double> grid(n), sse(n);
+    for(int i = 0; i < n; ++i) grid[i] = n > 1 ? lo + (hi - lo) * i / (n - 1) : lo;
+    QVector<int> order;
+    order << 0;
+    if(n > 1) order << n - 1;
+    for(int i = 1; i < n - 1; ++i) order << i;
+    for(int i : order) {
+        if(!trial(grid[i], sse[i])) return false;
+    }
+
+    // 2. 黄金分割
+    if(n > 1) {
+        int b = 0;
+        for(int i = 1; i < n; ++i) if(sse[i] < sse[b]) b = i;
+        const double g = 0.5 * (std::sqrt(5.0) - 1.0);
+        double a = grid[qMax(b - 1, 0)], c = grid[qMin(b + 1, n - 1)];
+        double x1 = c - g * (c - a), x2 = a + g * (c - a), f1, f2;
+        if(!trial(x1, f1) || !trial(x2, f2)) return false;
+        while(c - a > kTolerance) {
+            if(f1 < f2) {
+                c = x2; x2 = x1; f2 = f1;
+                x1 = c - g * (c - a);
+                if(!trial(x1, f1)) return false;
+            } else {
+                a = x1; x1 = x2; f1 = f2;
+                x2 = a + g * (c - a);
+                if(!trial(x2, f2)) return false;
+            }
+        }
+    }
+
+    if(bestR.size() == 0) return false;
+    x = bestX;
+    r = bestR;
+    return true;
+}
+
+/**
+ * @brief 由参数列表构造拟合变量
+ * 对数敏感参数 (大部分试井参数如 k, C，但 S 和 nf 除外) 在 log10 域更新，取值域在拟合开始时一次确定，
+ * 参数范围 (Min/Max) 换算到同一域作为盒约束；下限不为正的对数参数只在上限以下 4 个对数周期内采样起点。
+ */
+FitVariables FitVariables::fromParameters(const QList<FitParameter>& params)
+{
+    FitVariables vars;
+    QMap<QString, double> initialMap;
+    for(const auto& p : params) initialMap.insert(p.name, p.value);
+    vars.base = ModelParamVector::fromMap(initialMap);
+    vars.base.updateDependent();
+
+    QVector<int> fitIndices;
+    for(int i=0; i<params.size(); ++i) {
+        int id = ModelParamVector::indexOf(params[i].name);
+        if(params[i].isFit && id >= 0) {
+            fitIndices.append(i);
+            vars.fitIds.append(id);
+            vars.displayNames.append(params[i].displayName.isEmpty() ? params[i].name : params[i].displayName);
+        }
+    }
+
+    int nParams = vars.fitIds.size();
+    vars.logScale.resize(nParams);
+    vars.x0.resize(nParams);
+    vars.lower.resize(nParams);
+    vars.upper.resize(nParams);
+    vars.sampleLower.resize(nParams);
+    vars.sampleUpper.resize(nParams);
+    for(int i=0; i<nParams; ++i) {
+        const FitParameter& fp = params[fitIndices[i]];
+        int pId = vars.fitIds[i];
+        double val = vars.base[pId];
+        vars.logScale[i] = (val > 1e-12 && pId != Param_S && pId != Param_nf);
+        if(vars.logScale[i]) {
+            vars.x0(i) = log10(val);
+            vars.lower(i) = log10(qMax(fp.min, 1e-300));
+            vars.upper(i) = log10(qMax(fp.max, 1e-300));
+            vars.sampleLower(i) = fp.min > 0.0 ? vars.lower(i) : vars.upper(i) - 4.0;
+        } else {
+            vars.x0(i) = val;
+            vars.lower(i) = fp.min;
+            vars.upper(i) = fp.max;
+            vars.sampleLower(i) = fp.min;
+        }
+        vars.sampleUpper(i) = vars.upper(i);
+    }
+    return vars;
+}
+
+ModelParamVector FitVariables::toParams(const Eigen::VectorXd& x) const
+{
+    ModelParamVector p = base;
+    for(int i=0; i<fitIds.size(); ++i) p[fitIds[i]] = logScale[i] ? pow(10.0, x(i)) : x(i);
+    p.updateDependent();
+    return p;
+}
+
+/**
+ * @brief 确定可消去的平移参数
+ * 压力平移取 h、q、B 中第一个勾选的对数域参数，时间平移取 phi、Ct 中第一个勾选的对数域参数；
+ * 同一类中其余勾选的参数与被消去的参数完全相关，仍留作 LM 未知量。
+ */
+ShiftProjection ShiftProjection::fromVariables(const FitVariables& vars, bool timeShift)
+{
+    ShiftProjection projection;
+    for(int i=0; i<vars.fitIds.size(); ++i) {
+        if(!vars.logScale[i]) continue;
+        int id = vars.fitIds[i];
+        if(projection.pressureVar < 0 && (id == Param_h || id == Param_q || id == Param_B)) projection.pressureVar = i;
+        else if(timeShift && projection.timeVar < 0 && (id == Param_phi || id == Param_Ct)) projection.timeVar = i;
+    }
+    for(int i=0; i<vars.fitIds.size(); ++i) {
+        if(i != projection.pressureVar && i != projection.timeVar) projection.freeVars.append(i);
+    }
+    return projection;
+}
+
+Eigen::VectorXd ShiftProjection::reduce(const Eigen::VectorXd& x) const
+{
+    Eigen::VectorXd xFree(freeVars.size());
+    for(int k=0; k<freeVars.size(); ++k) xFree(k) = x(freeVars[k]);
+    return xFree;
+}
+
+/**
+ * @brief 构造拟合的最小二乘问题
+ * 回调只读取数据快照与模型管理器 (按值捕获拟合变量)，可由多个候选并发调用；
+ * 计算前后都检查停止标志，被停止标志截断的计算结果不会交给优化器。
+ */
+LeastSquaresProblem FitJob::makeFitProblem(const FitVariables& vars)
+{
+    LeastSquaresProblem problem;
+    problem.lower = vars.lower;
+    problem.upper = vars.upper;
+    problem.residuals = [this, vars](const Eigen::VectorXd& x, Eigen::VectorXd& r) {
+        if(stopRequested()) return false;
+        QVector<double> res = calculateResiduals(vars.toParams(x), m_settings.fitData, iterationOptions());
+        if(res.isEmpty() || stopRequested()) return false;
+        r = Eigen::Map<const Eigen::VectorXd>(res.constData(), res.size());
+        return true;
+    };
+    problem.jacobian = [this, vars](const Eigen::VectorXd& x, const Eigen::VectorXd& r, Eigen::MatrixXd& J) {
+        if(stopRequested()) return false;
+        return computeJacobian(vars.toParams(x), r.size(), vars.fitIds, vars.logScale, J);
+    };
+    return problem;
+}
+
+/**
+ * @brief 拟合迭代使用的求解设置
+ * 按迭代精度选择最少的反演节点数；Laplace 解在代理网格上计算后插值到各节点 (相对误差远小于反演误差)；
+ * 数据点多于插值粗网格时只在粗网格上反演；节点循环检查停止标志
+ */
+ModelSolverOptions FitJob::iterationOptions() const
+{
+    ModelSolverOptions options(false);
+    options.inversionNodes = ModelSolver01_06::inversionNodesForTolerance(m_settings.inversionTolerance);
+    options.laplaceGridPointsPerDecade = 32;
+    options.interpolate = true;
+    options.cancel = &m_stop;
+    return options;
+}
+
+/**
+ * @brief 计算指定数据集上的残差向量
+ * @param data 拟合数据集 (抽稀数据或全分辨率数据)
+ * @param options 求解设置
+ * @param shiftColumn 非空时输出 dr/dlnF: 压力与导数都与 F 成正比，故为 -权重 (按下限计算的点为 0)
+ * @return 包含压差残差和导数残差的向量
+ */
+QVector<double> FitJob::calculateResiduals(const ModelParamVector& params, const LogSampledData& data, const ModelSolverOptions& options,
+                                           QVector<double>* shiftColumn) const
+{
+    if(!m_modelManager || data.isEmpty()) return QVector<double>();
+
+    // 调用模型管理器计算理论曲线
+    ModelCurveData res = m_modelManager->calculateTheoreticalCurve(m_settings.modelType, params, data.time, options);
+    const QVector<double>& pCal = std::get<1>(res);
+    const QVector<double>& dpCal = std::get<2>(res);
+
+    QVector<double> r;
+    double wp = m_settings.weight;
+    double wd = 1.0 - m_settings.weight;
+
+    // 计算压差残差 (基于对数差，更符合试井双对数图的拟合需求)
+    // 注意：data.deltaP 已经是压差；每个点按所在时间窗口的观测点数加权
+    // 理论值计算失败 (非正或非有限) 的点按下限 1e-10 计算残差，避免失败区域的误差反而为 0
+    int count = qMin(data.deltaP.size(), pCal.size());
+    r.reserve(2 * count);
+    if(shiftColumn) {
+        shiftColumn->clear();
+        shiftColumn->reserve(2 * count);
+    }
+    for(int i=0; i<count; ++i) {
+        if(data.deltaP[i] > 1e-10)
+            r.append( (log(data.deltaP[i]) - log(pCal[i] > 1e-10 ? pCal[i] : 1e-10)) * wp * data.weightP[i] );
+        else
+            r.append(0.0);
+        if(shiftColumn) shiftColumn->append(data.deltaP[i] > 1e-10 && pCal[i] > 1e-10 ? -wp * data.weightP[i] : 0.0);
+    }
+
+    // 计算导数残差
+    int dCount = qMin(data.derivative.size(), dpCal.size());
+    dCount = qMin(dCount, count);
+    for(int i=0; i<dCount; ++i) {
+        if(data.derivative[i] > 1e-10)
+            r.append( (log(data.derivative[i]) - log(dpCal[i] > 1e-10 ? dpCal[i] : 1e-10)) * wd * data.weightD[i] );
+        else
+            r.append(0.0);
+        if(shiftColumn) shiftColumn->append(data.derivative[i] > 1e-10 && dpCal[i] > 1e-10 ? -wd * data.weightD[i] : 0.0);
+    }
+    return r;
+}
+
+/**
+ * @brief 计算雅可比矩阵
+ * 连续参数的偏导数由一次前向自动微分计算得到 (解析导数，无差分步长与反演噪声的放大)；
+ * 与残差相同使用插值设置: 数据点多于插值粗网格时只在自适应对数粗网格上做对偶数反演，再插值到数据时间，
+ * 不抽稀的全分辨率数据也不会在每个观测时间上做对偶数反演，雅可比矩阵与残差同为粗网格插值曲线的导数；
+ * 整数参数 (裂缝条数) 仍用中心差分，其正向、负向扰动作为独立任务交给计算运行时并行计算，
+ * 各任务的残差写入预分配的连续矩阵的对应列；任务开始前检查停止标志。
+ * @param logScale 各拟合参数是否在对数域更新 (对数域参数对 log10 值求导)
+ * @param J 输出矩阵 (nRes x nParams)
+ * @return 全部计算完成返回 true，收到停止请求返回 false
+ */
+bool FitJob::computeJacobian(const ModelParamVector& params, int nRes, const QVector<int>& fitIds, const QVector<bool>& logScale,
+                             Eigen::MatrixXd& J)
+{
+    const LogSampledData& fitData = m_settings.fitData;
+    int nParams = fitIds.size();
+    J.setZero(nRes, nParams);
+
+    // 1. 划分参数: 连续参数走自动微分，整数参数及超出对偶数方向上限的参数走中心差分
+    QVector<int> adColumns, fdColumns;
+    for(int j = 0; j < nParams; ++j) {
+        int pId = fitIds[j];
+        bool discrete = (pId == Param_nf || pId == Param_N);
+        if(!discrete && adColumns.size() < DualNumber::kMaxDirections) adColumns.append(j);
+        else fdColumns.append(j);
+    }
+
+    // 2. 解析偏导数: 残差 r = (ln obs - ln cal) * w，故 dr/dθ = -w * (dcal/dθ) / cal，
+    //    对数域更新的参数再乘以 dθ/dlog10(θ) = θ * ln10
+    if(!adColumns.isEmpty()) {
+        QVector<int> adIds;
+        for(int j : adColumns) adIds.append(fitIds[j]);
+        ModelCurveSensitivity sens = m_modelManager->calculateCurveSensitivities(m_settings.modelType, params, adIds, fitData.time, iterationOptions());
+        if(stopRequested()) return false;
+
+        double wp = m_settings.weight;
+        double wd = 1.0 - m_settings.weight;
+        int count = qMin(fitData.deltaP.size(), sens.pressure.size());
+        int dCount = qMin(qMin(fitData.derivative.size(), sens.derivative.size()), count);
+
+        if(count + dCount == nRes && sens.dPressure.size() == adColumns.size()) {
+            for(int k = 0; k < adColumns.size(); ++k) {
+                int j = adColumns[k];
+                double scale = logScale[j] ? params[fitIds[j]] * std::log(10.0) : 1.0;
+
+                for(int i = 0; i < count; ++i) {
+                    if(fitData.deltaP[i] > 1e-10 && sens.pressure[i] > 1e-10)
+                        J(i, j) = -wp * fitData.weightP[i] * sens.dPressure[k][i] / sens.pressure[i] * scale;
+                }
+                for(int i = 0; i < dCount; ++i) {
+                    if(fitData.derivative[i] > 1e-10 && sens.derivative[i] > 1e-10)
+                        J(count + i, j) = -wd * fitData.weightD[i] * sens.dDerivative[k][i] / sens.derivative[i] * scale;
+                }
+            }
+        } else {
+            // 灵敏度计算失败 (如参数个数超限)，退回差分
+            fdColumns += adColumns;
+        }
+    }
+    if(fdColumns.isEmpty()) return true;
+
+    // 3. 构造差分扰动参数向量 (参数向量按值拷贝，无堆分配)
+    int nFd = fdColumns.size();
+    QVector<ModelParamVector> perturbed(2 * nFd, params);
+    QVector<double> steps(nFd);
+    for(int k = 0; k < nFd; ++k) {
+        int pId = fitIds[fdColumns[k]];
+        double val = params[pId];
+        bool isLog = logScale[fdColumns[k]];
+
+        ModelParamVector& pPlus = perturbed[2 * k];
+        ModelParamVector& pMinus = perturbed[2 * k + 1];
+        double h;
+        if(isLog) {
+            h = 0.01; // 对数域步长
+            double valLog = log10(val);
+            pPlus[pId] = pow(10.0, valLog + h);
+            pMinus[pId] = pow(10.0, valLog - h);
+        } else {
+            h = 1e-4; // 线性域步长
+            pPlus[pId] = val + h;
+            pMinus[pId] = val - h;
+        }
+        steps[k] = h;
+
+        // 联动更新
+        if(pId == Param_L || pId == Param_Lf) { pPlus.updateDependent(); pMinus.updateDependent(); }
+    }
+
+    // 4. 并行计算各扰动的残差，结果写入预分配矩阵的第 task 列 (列存储，各任务写入互不重叠的连续内存)
+    //    任务内部的节点网格继续并行，空闲线程从扰动与节点块两级窃取任务，扰动数少于核数时也不会空闲
+    Eigen::MatrixXd perturbedRes = Eigen::MatrixXd::Zero(nRes, 2 * nFd);
+    QVector<bool> done(2 * nFd, false);
+    ModelSolverOptions taskOptions = iterationOptions();
+
+    const ModelParamVector* perturbedPtr = perturbed.constData();
+    bool* donePtr = done.data();
+    ComputeRuntime::instance()->parallelFor(2 * nFd, [&](int task) {
+        if(stopRequested()) return;
+        QVector<double> r = calculateResiduals(perturbedPtr[task], fitData, taskOptions);
+        if(r.size() != nRes) return;
+        for(int i = 0; i < nRes; ++i) perturbedRes(i, task) = r[i];
+        donePtr[task] = true;
+    });
+    if(stopRequested()) return false;
+
+    // 5. 中心差分公式: df/dx = (f(x+h) - f(x-h)) / 2h
+    for(int k = 0; k < nFd; ++k) {
+        if(done[2 * k] && done[2 * k + 1]) {
+            J.col(fdColumns[k]) = (perturbedRes.col(2 * k) - perturbedRes.col(2 * k + 1)) / (2.0 * steps[k]);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 计算误差平方和 (SSE)
+ */
+double FitJob::calculateSumSquaredError(const QVector<double>& residuals)
+{
+    double sse = 0.0;
+    for(double v : residuals) sse += v*v;
+    return sse;
+}
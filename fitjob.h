@@ -0,0 +1,192 @@
+/*
+ * 文件名: fitjob.h
+ * 文件作用: 拟合任务头文件
+ * 功能描述:
+ * 1. 拟合任务在创建时复制拟合数据 (抽稀数据与全分辨率数据)、参数表和拟合设置，运行期间不访问界面对象；
+ *    界面在拟合中修改观测数据或参数不影响正在运行的任务，多个任务可同时运行。
+ * 2. 任务由全局调度器 (fitscheduler.h) 排队并在计算运行时的工作线程上执行，future() 返回 QFuture<FitJobResult>:
+ *    进度 (0~100) 经 QPromise 报告，结束时报告唯一结果；迭代中的参数与误差写入任务自带的无锁进度槽 (fitprogressslot.h)。
+ * 3. requestStop() 设置原子停止标志: 优化器在当前步结束，保留已得到的最优解并正常报告结果；
+ *    cancel() 同时取消 QFuture，不再计算最终曲线、不报告结果。
+ * 4. 停止标志经 ModelSolverOptions 传入模型计算的节点循环，请求在当前一小块节点计算完成后即生效。
+ * 5. 变量投影 (可选，LM 迭代): 压力平移参数 (h、q、B) 与时间平移参数 (phi、Ct) 只使双对数曲线平移，
+ *    残差对压力平移 ln F 是线性的。勾选后这两个参数不作为 LM 的未知量: 每个试探点先一维搜索时间平移
+ *    (只改变时间比例，在无因次曲线缓存上插值)，再闭式求解压力平移，雅可比矩阵取投影掉平移方向后的部分，
+ *    结束时平移量换算回参数本身。
+ */
+
+#ifndef FITJOB_H
+#define FITJOB_H
+
+#include <QFuture>
+#include <QPromise>
+#include <QList>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include <Eigen/Dense>
+#include "modelmanager.h"
+#include "fittingparameterchart.h"
+#include "logtimeresampler.h"
+#include "levenbergmarquardt.h"
+#include "multistartfitter.h"
+#include "differentialevolution.h"
+#include "fitprogressslot.h"
+
+// 单次拟合使用的优化算法 (与界面下拉框的选项顺序一致)
+enum FitOptimizer {
+    Optimizer_LevenbergMarquardt = 0,  // 信赖域 LM (局部)
+    Optimizer_DifferentialEvolution    // 差分进化 (全局)，可选 LM 精修
+};
+
+// 拟合迭代统计
+struct FitIterationStats {
+    int iterations = 0;            // 试探步数
+    int jacobianEvaluations = 0;   // 完整计算雅可比矩阵的次数
+    int broydenUpdates = 0;        // Broyden 秩一更新次数
+    int residualEvaluations = 0;   // 残差 (试探步) 计算次数
+    int generations = 0;           // 差分进化代数
+    int shiftEvaluations = 0;      // 变量投影时间平移搜索的残差计算次数
+};
+
+// 拟合变量: 勾选参数在优化空间 (对数敏感参数为 log10 域) 中的初值、盒约束与起点采样范围
+struct FitVariables {
+    QVector<int> fitIds;               // 参数向量下标
+    QStringList displayNames;          // 参数显示名
+    QVector<bool> logScale;            // 是否在 log10 域
+    Eigen::VectorXd x0, lower, upper;
+    Eigen::VectorXd sampleLower, sampleUpper;
+    ModelParamVector base;             // 未拟合参数的取值
+
+    // 由参数列表构造 (勾选且可识别的参数)
+    static FitVariables fromParameters(const QList<FitParameter>& params);
+
+    // 优化变量 -> 参数向量 (含参数联动更新)
+    ModelParamVector toParams(const Eigen::VectorXd& x) const;
+};
+
+// 变量投影: 被消去的平移参数在拟合变量中的位置，其余拟合变量为 LM 的未知量
+struct ShiftProjection {
+    int pressureVar = -1;              // 压力平移参数 (h、q、B 中第一个勾选的)，闭式求解
+    int timeVar = -1;                  // 时间平移参数 (phi、Ct 中第一个勾选的)，一维搜索
+    QVector<int> freeVars;             // LM 未知量对应的拟合变量下标
+
+    // 由拟合变量确定可消去的平移参数 (只取对数域参数)；timeShift 为 false 时不消去时间平移
+    static ShiftProjection fromVariables(const FitVariables& vars, bool timeShift);
+
+    bool active() const { return pressureVar >= 0 || timeVar >= 0; }
+
+    // 拟合变量 -> LM 未知量
+    Eigen::VectorXd reduce(const Eigen::VectorXd& x) const;
+};
+
+// 拟合设置与数据快照 (创建任务时按值复制)
+struct FitJobSettings {
+    ModelManager::ModelType modelType = ModelManager::Model_1;
+    QList<FitParameter> params;        // 参数表 (初值、范围、是否拟合)
+    double weight = 0.5;               // 压力权重 (导数权重为 1 - weight)
+    LogSampledData fitData;            // 拟合迭代使用的抽稀数据
+    LogSampledData fullData;           // 全分辨率数据 (计算最终误差；为空表示未抽稀)
+    bool global = false;               // 多起点全局拟合
+    int globalStarts = 16;             // 全局拟合的拉丁超立方起点数
+    FitOptimizer optimizer = Optimizer_LevenbergMarquardt;
+    bool polishWithLM = true;          // 差分进化结束后从最优个体出发运行 LM 精修
+    bool broydenUpdate = false;        // 迭代间用 Broyden 秩一更新雅可比矩阵
+    bool variableProjection = false;   // LM 迭代中消去压力平移参数 (变量投影)
+    bool projectTimeShift = false;     // 变量投影同时消去时间平移参数
+    double inversionTolerance = 0.1;   // 迭代中理论曲线的相对误差上限 (选择 Stehfest 节点数，0.1 对应 4 个节点)
+};
+
+// 拟合结果
+struct FitJobResult {
+    bool valid = false;                // 是否得到了拟合参数 (未勾选拟合参数时为 false)
+    bool stopped = false;              // 是否因停止请求提前结束
+    ModelParamVector params;           // 最终参数
+    double mse = 0.0;                  // 全分辨率数据上的均方误差
+    ModelCurveData curve;              // 最终参数的高精度理论曲线
+    FitIterationStats stats;
+    FitVariables variables;            // 拟合变量 (全局拟合结果列表使用)
+    QVector<MultiStartCandidate> candidates; // 全局拟合的候选解 (按均方误差排序)
+};
+
+class FitJob
+{
+public:
+    FitJob(ModelManager* modelManager, const FitJobSettings& settings);
+
+    // 任务结果 (创建后即可获取；排队期间处于未开始状态)
+    QFuture<FitJobResult> future() const { return m_future; }
+
+    // 在当前线程运行拟合并结束 future (由调度器调用，只调用一次)
+    void execute();
+
+    // 停止: 保留当前最优解并报告结果
+    void requestStop();
+
+    // 取消: 停止并放弃结果
+    void cancel();
+
+    bool stopRequested() const { return m_stop.load(std::memory_order_relaxed); }
+
+    // 读取最新的迭代参数与误差 (单读端)
+    bool takeProgress(FitProgressSnapshot& snapshot) { return m_progress.take(snapshot); }
+
+    const FitJobSettings& settings() const { return m_settings; }
+
+private:
+    struct ShiftMemory;
+
+    void run();
+
+    // 各优化算法 (在拟合线程中运行)，最终参数与迭代误差写入 params / iterationMSE
+    void runLevenbergMarquardt(const FitVariables& vars, FitJobResult& result, ModelParamVector& params, double& iterationMSE);
+    void runMultiStart(const FitVariables& vars, FitJobResult& result, ModelParamVector& params, double& iterationMSE);
+    void runDifferentialEvolution(const FitVariables& vars, FitJobResult& result, ModelParamVector& params, double& iterationMSE);
+
+    // 运行 LM (单次拟合与差分进化精修)，勾选变量投影时消去平移参数；返回结果的 x 为完整的拟合变量
+    // onStep 参数为 (试探步序号, 拟合变量, 均方误差)
+    LevenbergMarquardtResult solveLevenbergMarquardt(const FitVariables& vars, const LevenbergMarquardtOptions& options,
+                                                     const Eigen::VectorXd& x0, FitIterationStats& stats,
+                                                     const std::function<bool(int, const Eigen::VectorXd&, double)>& onStep);
+
+    // 变量投影的最小二乘问题 (未知量为 projection.freeVars)，已求解的平移量记录在 memory 中
+    LeastSquaresProblem makeProjectedProblem(const FitVariables& vars, const ShiftProjection& projection,
+                                             const std::shared_ptr<ShiftMemory>& memory);
+
+    // 求解平移参数: x 为完整的拟合变量 (平移参数为初值)，返回时写入最优平移量及对应残差；
+    // evaluations 累加时间平移搜索的残差计算次数
+    bool solveShifts(const FitVariables& vars, const ShiftProjection& projection, Eigen::VectorXd& x, Eigen::VectorXd& r,
+                     int& evaluations) const;
+
+    // 报告进度并发布当前参数；返回 false 表示应当停止 (含 QFuture 被取消的情况)
+    bool reportProgress(int progress, const ModelParamVector& params, double mse);
+
+    // 构造拟合的最小二乘问题 (残差、雅可比回调可并发调用，收到停止请求时中止)
+    LeastSquaresProblem makeFitProblem(const FitVariables& vars);
+
+    // 拟合迭代使用的求解设置（低精度 + 插值模式，带停止标志）
+    ModelSolverOptions iterationOptions() const;
+
+    // 计算指定数据集上的残差向量（残差按数据集中的箱权重加权）
+    // shiftColumn 非空时输出残差对压力系数对数 ln F 的偏导数 (压力与导数同比例缩放)
+    QVector<double> calculateResiduals(const ModelParamVector& params, const LogSampledData& data, const ModelSolverOptions& options,
+                                       QVector<double>* shiftColumn = nullptr) const;
+
+    // 计算雅可比矩阵（连续参数为自动微分解析导数，整数参数为中心差分），收到停止请求时返回 false
+    // logScale[j] 为真的参数对 log10 值求导
+    bool computeJacobian(const ModelParamVector& params, int nRes, const QVector<int>& fitIds, const QVector<bool>& logScale,
+                         Eigen::MatrixXd& J);
+
+    // 计算残差平方和（SSE）
+    static double calculateSumSquaredError(const QVector<double>& residuals);
+
+    ModelManager* m_modelManager;          // 模型计算核心 (求解器无可变状态，可并发调用)
+    const FitJobSettings m_settings;       // 数据与设置快照 (运行期间只读)
+    std::atomic<bool> m_stop{false};       // 停止标志 (拟合线程、雅可比任务与模型节点循环中读取)
+    FitProgressSlot m_progress;            // 最新的参数与误差 (拟合线程写，界面线程读)
+    QPromise<FitJobResult> m_promise;      // 结果与进度 (仅执行线程写入)
+    QFuture<FitJobResult> m_future;        // m_promise 对应的 future (cancel() 使用)
+};
+
+#endif // FITJOB_H
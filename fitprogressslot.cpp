@@ -0,0 +1,30 @@
+/*
+ * 文件名: fitprogressslot.cpp
+ * 文件作用: 拟合进度无锁槽实现
+ * 功能描述:
+ * 1. 写端写完自己的缓冲后与中间缓冲交换 (release)，读端发现新标志后再与中间缓冲交换 (acquire)，
+ *    快照内容的可见性由这两次交换保证。
+ */
+
+#include "fitprogressslot.h"
+
+FitProgressSlot::FitProgressSlot()
+    : m_middle(1), m_back(0), m_front(2)
+{
+}
+
+void FitProgressSlot::publish(const FitProgressSnapshot& snapshot)
+{
+    m_buffers[m_back] = snapshot;
+    int previous = m_middle.exchange(m_back | kFresh, std::memory_order_acq_rel);
+    m_back = previous & ~kFresh;
+}
+
+bool FitProgressSlot::take(FitProgressSnapshot& snapshot)
+{
+    if (!(m_middle.load(std::memory_order_relaxed) & kFresh)) return false;
+    int previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+    m_front = previous & ~kFresh;
+    snapshot = m_buffers[m_front];
+    return true;
+}
@@ -0,0 +1,42 @@
+/*
+ * 文件名: fitprogressslot.h
+ * 文件作用: 拟合进度的无锁“最新值”槽头文件
+ * 功能描述:
+ * 1. 拟合线程每次接受步长 (或每代、每轮) 后只写入当前参数向量和均方误差，不计算曲线、不等待界面。
+ * 2. 界面线程按固定帧率读取最新值；两次读取之间的多次写入只保留最后一次。
+ * 3. 三缓冲实现: 写端和读端各持有一个缓冲，中间缓冲通过一次原子交换传递，双方都不会阻塞。
+ *    仅支持单写端、单读端 (拟合线程写，界面线程读)。
+ */
+
+#ifndef FITPROGRESSSLOT_H
+#define FITPROGRESSSLOT_H
+
+#include <atomic>
+#include "modelparamvector.h"
+
+struct FitProgressSnapshot {
+    ModelParamVector params;   // 当前 (最优) 参数
+    double mse = 0.0;          // 迭代数据上的均方误差
+};
+
+class FitProgressSlot
+{
+public:
+    FitProgressSlot();
+
+    // 写端: 发布最新快照 (覆盖尚未被读取的旧快照)
+    void publish(const FitProgressSnapshot& snapshot);
+
+    // 读端: 取出自上次读取以来最新的快照，没有新快照时返回 false
+    bool take(FitProgressSnapshot& snapshot);
+
+private:
+    static constexpr int kFresh = 4;   // 中间缓冲含未读取快照的标志位 (低两位为缓冲下标)
+
+    FitProgressSnapshot m_buffers[3];
+    std::atomic<int> m_middle;         // 中间缓冲下标 | kFresh
+    int m_back;                        // 写端缓冲 (仅写端访问)
+    int m_front;                       // 读端缓冲 (仅读端访问)
+};
+
+#endif // FITPROGRESSSLOT_H
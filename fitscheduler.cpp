@@ -0,0 +1,110 @@
+/*
+ * 文件名: fitscheduler.cpp
+ * 文件作用: 全局拟合任务调度器实现
+ * 功能描述:
+ * 1. 任务结束后在工作线程中减少运行计数并启动下一个排队任务；撤销的排队任务立即以取消状态结束。
+ * 2. 提交时按优先级插入等待队列，队列顺序即启动顺序，排队位置直接由下标得到。
+ */
+
+#include "fitscheduler.h"
+#include "computeruntime.h"
+#include <QMutexLocker>
+#include <QPromise>
+
+FitScheduler* FitScheduler::instance()
+{
+    static FitScheduler scheduler;
+    return &scheduler;
+}
+
+FitScheduler::FitScheduler()
+    : m_pool(QThreadPool::globalInstance()), m_running(0)
+{
+    // 拟合任务最多占用 (工作线程数 - 1) 个工作线程，其余线程专门窃取内层工作
+    m_maxRunning = qMax(1, ComputeRuntime::instance()->workerCount() - 1);
+}
+
+QFuture<FitJobResult> FitScheduler::submit(const std::shared_ptr<FitJob>& job, Priority priority)
+{
+    QMutexLocker locker(&m_mutex);
+    int pos = m_queue.size();
+    while (pos > 0 && m_queue[pos - 1].priority < priority) --pos;
+    m_queue.insert(pos, QueuedJob{job, priority});
+    dispatchLocked();
+    return job->future();
+}
+
+void FitScheduler::dispatchLocked()
+{
+    while (m_running < m_maxRunning && !m_queue.isEmpty()) {
+        std::shared_ptr<FitJob> job = m_queue.takeFirst().job;
+        ++m_running;
+        ComputeRuntime::instance()->submit([this, job]() {
+            job->execute();
+            QMutexLocker locker(&m_mutex);
+            --m_running;
+            dispatchLocked();
+        });
+    }
+}
+
+bool FitScheduler::withdraw(const std::shared_ptr<FitJob>& job)
+{
+    QMutexLocker locker(&m_mutex);
+    for (int i = 0; i < m_queue.size(); ++i) {
+        if (m_queue[i].job == job) {
+            m_queue.removeAt(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void FitScheduler::stop(const std::shared_ptr<FitJob>& job)
+{
+    if (!job) return;
+    if (withdraw(job)) {
+        job->cancel();
+        job->execute();   // 已取消: 只把 future 置为结束
+    } else {
+        job->requestStop();
+    }
+}
+
+void FitScheduler::cancel(const std::shared_ptr<FitJob>& job)
+{
+    if (!job) return;
+    bool queued = withdraw(job);
+    job->cancel();
+    if (queued) job->execute();
+}
+
+QFuture<void> FitScheduler::runInteractive(const std::function<void()>& task)
+{
+    auto promise = std::make_shared<QPromise<void>>();
+    QFuture<void> future = promise->future();
+    m_pool->start([promise, task]() {
+        promise->start();
+        {
+            ComputeRuntime::InteractiveScope interactive;
+            task();
+        }
+        promise->finish();
+    }, Priority_Interactive);
+    return future;
+}
+
+int FitScheduler::queuePosition(const FitJob* job) const
+{
+    QMutexLocker locker(&m_mutex);
+    for (int i = 0; i < m_queue.size(); ++i) {
+        if (m_queue[i].job.get() == job) return i + 1;
+    }
+    return 0;
+}
+
+int FitScheduler::runningJobs() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_running;
+}
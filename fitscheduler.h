@@ -0,0 +1,80 @@
+/*
+ * 文件名: fitscheduler.h
+ * 文件作用: 全局拟合任务调度器头文件
+ * 功能描述:
+ * 1. 所有拟合页签的拟合任务提交到同一个调度器，按优先级排队 (同一优先级按提交顺序)；同时运行的任务数有上限
+ *    (计算线程数 - 1，至少 1 个)，超出的任务排队等待前面的任务结束。
+ * 2. 拟合任务作为顶层任务在计算运行时 (computeruntime.h) 的工作线程上运行，任务内部的种群/候选/雅可比扰动
+ *    与模型节点网格经同一运行时嵌套并行: 空闲线程按工作窃取分担各任务的内层工作，线程数不超过 CPU 核数。
+ * 3. 优先级: 界面交互计算 (预览曲线) 以高优先级提交到 Qt 全局线程池，不排在拟合任务之后；
+ *    其内部的并行计算在计算运行时中标记为交互区间，空闲的工作线程先于拟合的区间领取，
+ *    运行任务数上限保证至少一个工作线程可以及时协助。
+ * 4. 排队: 局部拟合 (LM，通常数秒) 排在全局拟合 (多起点、差分进化) 之前启动，长任务不阻塞短任务；
+ *    运行中的任务各自驱动迭代，内层区间由空闲线程从各任务的队列中轮流窃取。
+ */
+
+#ifndef FITSCHEDULER_H
+#define FITSCHEDULER_H
+
+#include <QFuture>
+#include <QList>
+#include <QMutex>
+#include <QThreadPool>
+#include <functional>
+#include <memory>
+#include "fitjob.h"
+
+class FitScheduler
+{
+public:
+    // 拟合任务的排队优先级，与交互任务在 Qt 全局线程池中的优先级 (高于其他排队任务)
+    enum Priority {
+        Priority_Global = 0,        // 全局拟合 (多起点、差分进化)
+        Priority_Local = 1,         // 局部拟合 (LM)
+        Priority_Interactive = 10
+    };
+
+    // 进程内唯一的调度器
+    static FitScheduler* instance();
+
+    // 提交拟合任务 (有空位时立即启动，否则排在优先级不低于它的任务之后)，返回任务的 future
+    QFuture<FitJobResult> submit(const std::shared_ptr<FitJob>& job, Priority priority = Priority_Local);
+
+    // 停止: 排队中的任务直接撤销 (不报告结果)；运行中的任务在当前步结束，保留已得到的最优解
+    void stop(const std::shared_ptr<FitJob>& job);
+
+    // 取消: 排队中的任务直接撤销；运行中的任务停止并放弃结果
+    void cancel(const std::shared_ptr<FitJob>& job);
+
+    // 以交互优先级在 Qt 全局线程池中运行 (内部的 parallelFor 为交互区间)
+    QFuture<void> runInteractive(const std::function<void()>& task);
+
+    // 任务在等待队列中的位置 (从 1 开始，不在队列中返回 0)
+    int queuePosition(const FitJob* job) const;
+
+    int runningJobs() const;
+    int maxRunningJobs() const { return m_maxRunning; }
+
+private:
+    FitScheduler();
+
+    // 排队中的任务
+    struct QueuedJob {
+        std::shared_ptr<FitJob> job;
+        Priority priority;
+    };
+
+    // 在空位内按队列顺序启动排队任务 (调用时已持有锁)
+    void dispatchLocked();
+
+    // 从等待队列中移除任务，返回是否移除
+    bool withdraw(const std::shared_ptr<FitJob>& job);
+
+    QThreadPool* m_pool;                   // 交互任务线程池 (Qt 全局线程池)
+    int m_maxRunning;                      // 同时运行的任务数上限
+    mutable QMutex m_mutex;
+    QList<QueuedJob> m_queue;              // 等待队列 (优先级降序，同一优先级按提交顺序)
+    int m_running;                         // 运行中的任务数
+};
+
+#endif // FITSCHEDULER_H
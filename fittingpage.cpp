@@ -12,6 +12,8 @@
 #include "wt_fittingwidget.h"
 #include "modelparameter.h"
 #include <QInputDialog>
+#include <QLabel>
+#include <QTabBar>
 #include <QMessageBox>
 #include <QJsonArray>
 #include <QDebug>
@@ -87,6 +89,16 @@ FittingWidget* FittingPage::createNewTab(const QString &name, const QJsonObject
     int index = ui->tabWidget->addTab(w, name);
     ui->tabWidget->setCurrentIndex(index);
 
+    // 页签右侧显示该分析的拟合状态 (排队/进度/结束)，页签文字仍为分析名称
+    QLabel* status = new QLabel(ui->tabWidget);
+    status->setStyleSheet("color: #606060;");
+    status->setVisible(false);
+    ui->tabWidget->tabBar()->setTabButton(index, QTabBar::RightSide, status);
+    connect(w, &FittingWidget::sigFitStatusChanged, status, [status](const QString& text) {
+        status->setText(text);
+        status->setVisible(!text.isEmpty());
+    });
+
     if(!initData.isEmpty()) {
         w->loadFittingState(initData);
     }
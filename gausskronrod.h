@@ -0,0 +1,229 @@
+/*
+ * 文件名: gausskronrod.h
+ * 文件作用: 自适应 Gauss-Kronrod 数值积分模板
+ * 功能描述:
+ * 1. 采用 7 点 Gauss / 15 点 Kronrod 嵌套公式，一次 15 点计算同时得到积分值和误差估计。
+ * 2. 每个子区间的积分与误差只计算一次并保存，按全局误差最大优先 (优先队列) 二分细化，
+ *    不再像深度优先递归那样重复计算已求过的半区间。
+ * 3. 被积函数以模板参数传入，可被编译器内联；通过 QuadratureStats 返回被积函数调用次数。
+ * 4. 批量版本一次传入一个子区间的全部 15 个节点，便于被积函数内部成组调用向量化的特殊函数。
+ * 5. 标量版本的被积函数值可为 double 以外的标量类型 (如 DualNumber)，误差估计与细化只看函数值。
+ * 6. 子区间堆的存储每个线程保留一份 (容量只增不减)，反复积分不申请堆内存；被积函数内嵌套积分时内层使用临时存储。
+ */
+
+#ifndef GAUSSKRONROD_H
+#define GAUSSKRONROD_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// 积分统计信息 (用于评估积分开销)
+struct QuadratureStats {
+    long long evaluations = 0;  // 被积函数调用次数
+    int intervals = 0;          // 最终子区间数
+    bool converged = true;      // 是否在子区间上限内达到精度
+};
+
+namespace GaussKronrod {
+
+// 15 点 Kronrod 节点 (正半轴，最后一个为中点)，奇数下标同时为 7 点 Gauss 节点
+static const double kNodes[8] = {
+    0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+    0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+    0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+    0.207784955007898467600689403773245, 0.000000000000000000000000000000000
+};
+static const double kKronrodWeights[8] = {
+    0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+    0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+    0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+    0.204432940075298892414161999234649, 0.209482141084727828012999174891714
+};
+static const double kGaussWeights[4] = {
+    0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+    0.381830050505118944950369775488975, 0.417959183673469387755102040816327
+};
+
+template <typename V = double>
+struct Segment {
+    double a, b;
+    V value;
+    double error;
+    bool operator<(const Segment& other) const { return error < other.error; }
+};
+
+// 积分值的大小 (误差判据用)，非 double 类型须可显式转换为 double (取函数值)
+inline double magnitude(double v) { return std::abs(v); }
+template <typename V>
+inline double magnitude(const V& v) { return std::abs(static_cast<double>(v)); }
+
+// 单区间 G7-K15 计算: 返回 Kronrod 积分值，error 为 |K15 - G7|
+template <typename F>
+inline auto evaluateSegment(F& f, double a, double b) -> Segment<decltype(f(a))>
+{
+    using V = decltype(f(a));
+    double c = 0.5 * (a + b);
+    double h = 0.5 * (b - a);
+    V fc = f(c);
+    V resK = fc * kKronrodWeights[7];
+    V resG = fc * kGaussWeights[3];
+    for (int j = 0; j < 7; ++j) {
+        double dx = h * kNodes[j];
+        V fsum = f(c - dx) + f(c + dx);
+        resK += kKronrodWeights[j] * fsum;
+        if (j % 2 == 1) resG += kGaussWeights[j / 2] * fsum;
+    }
+    Segment<V> s;
+    s.a = a; s.b = b;
+    s.value = resK * h;
+    s.error = magnitude((resK - resG) * h);
+    return s;
+}
+
+// 单区间 G7-K15 计算 (批量被积函数 f(const double* x, double* y, int n))
+template <typename F>
+inline Segment<> evaluateSegmentBatch(F& f, double a, double b)
+{
+    double c = 0.5 * (a + b);
+    double h = 0.5 * (b - a);
+    double x[15], y[15];
+    x[0] = c;
+    for (int j = 0; j < 7; ++j) {
+        x[1 + 2 * j] = c - h * kNodes[j];
+        x[2 + 2 * j] = c + h * kNodes[j];
+    }
+    f(x, y, 15);
+    double resK = y[0] * kKronrodWeights[7];
+    double resG = y[0] * kGaussWeights[3];
+    for (int j = 0; j < 7; ++j) {
+        double fsum = y[1 + 2 * j] + y[2 + 2 * j];
+        resK += kKronrodWeights[j] * fsum;
+        if (j % 2 == 1) resG += kGaussWeights[j / 2] * fsum;
+    }
+    Segment<> s;
+    s.a = a; s.b = b;
+    s.value = resK * h;
+    s.error = std::abs((resK - resG) * h);
+    return s;
+}
+
+// 每个线程按子区间类型复用的堆存储，inUse 防止嵌套积分共用同一份存储
+template <typename S>
+struct SegmentHeapStorage {
+    std::vector<S> segments;
+    bool inUse = false;
+
+    static SegmentHeapStorage& local()
+    {
+        thread_local SegmentHeapStorage storage;
+        return storage;
+    }
+};
+
+template <typename S>
+class SegmentHeapLease {
+public:
+    SegmentHeapLease() : m_storage(SegmentHeapStorage<S>::local()), m_shared(!m_storage.inUse)
+    {
+        if (m_shared) m_storage.inUse = true;
+    }
+    ~SegmentHeapLease() { if (m_shared) m_storage.inUse = false; }
+    SegmentHeapLease(const SegmentHeapLease&) = delete;
+    SegmentHeapLease& operator=(const SegmentHeapLease&) = delete;
+
+    std::vector<S>& segments() { return m_shared ? m_storage.segments : m_local; }
+
+private:
+    SegmentHeapStorage<S>& m_storage;
+    bool m_shared;
+    std::vector<S> m_local;
+};
+
+// 全局自适应细化主循环，eval(a, b) 返回单区间的 Segment
+template <typename SegmentEval>
+auto integrateAdaptive(SegmentEval&& eval, double a, double b, double absTol, double relTol,
+                       int maxIntervals, QuadratureStats* stats) -> decltype(eval(a, b).value)
+{
+    using S = decltype(eval(a, b));
+    S whole = eval(a, b);
+    auto total = whole.value;
+    double totalError = whole.error;
+    long long evals = 15;
+
+    // 以误差为键的大顶堆，堆顶为当前误差最大的子区间
+    SegmentHeapLease<S> lease;
+    std::vector<S>& heap = lease.segments();
+    heap.clear();
+    heap.reserve(maxIntervals + 1);
+    heap.push_back(whole);
+
+    while (totalError > std::max(absTol, relTol * magnitude(total)) && (int)heap.size() < maxIntervals) {
+        std::pop_heap(heap.begin(), heap.end());
+        S worst = heap.back();
+        heap.pop_back();
+
+        double mid = 0.5 * (worst.a + worst.b);
+        S left = eval(worst.a, mid);
+        S right = eval(mid, worst.b);
+        evals += 30;
+
+        // 用两个子区间替换父区间的贡献，其余区间的结果保持不变
+        total += left.value + right.value - worst.value;
+        totalError += left.error + right.error - worst.error;
+        heap.push_back(left);
+        std::push_heap(heap.begin(), heap.end());
+        heap.push_back(right);
+        std::push_heap(heap.begin(), heap.end());
+    }
+
+    // 最终结果按子区间重新求和，避免增量更新累积舍入误差
+    if (heap.size() > 1) {
+        total = 0.0;
+        totalError = 0.0;
+        for (const S& s : heap) { total += s.value; totalError += s.error; }
+    }
+
+    if (stats) {
+        stats->evaluations += evals;
+        stats->intervals += (int)heap.size();
+        if (totalError > std::max(absTol, relTol * magnitude(total))) stats->converged = false;
+    }
+    return total;
+}
+
+} // namespace GaussKronrod
+
+/**
+ * @brief 全局自适应 Gauss-Kronrod 积分
+ * @param f            被积函数 (任意可调用对象，按模板内联)，返回 double 或 DualNumber 等标量类型
+ * @param a, b         积分区间
+ * @param absTol       绝对误差限
+ * @param relTol       相对误差限
+ * @param maxIntervals 子区间数上限
+ * @param stats        可选的统计输出
+ */
+template <typename F>
+auto integrateGaussKronrod(F&& f, double a, double b, double absTol, double relTol,
+                           int maxIntervals = 1024, QuadratureStats* stats = nullptr) -> decltype(f(a))
+{
+    return GaussKronrod::integrateAdaptive(
+        [&](double lo, double hi) { return GaussKronrod::evaluateSegment(f, lo, hi); },
+        a, b, absTol, relTol, maxIntervals, stats);
+}
+
+/**
+ * @brief 全局自适应 Gauss-Kronrod 积分 (批量被积函数)
+ * @param f 批量被积函数 f(const double* x, double* y, int n)，每次传入一个子区间的 15 个节点
+ * 其余参数同 integrateGaussKronrod
+ */
+template <typename F>
+double integrateGaussKronrodBatch(F&& f, double a, double b, double absTol, double relTol,
+                                  int maxIntervals = 1024, QuadratureStats* stats = nullptr)
+{
+    return GaussKronrod::integrateAdaptive(
+        [&](double lo, double hi) { return GaussKronrod::evaluateSegmentBatch(f, lo, hi); },
+        a, b, absTol, relTol, maxIntervals, stats);
+}
+
+#endif // GAUSSKRONROD_H
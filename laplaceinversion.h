@@ -0,0 +1,66 @@
+/*
+ * 文件名: laplaceinversion.h
+ * 文件作用: Laplace 数值反演头文件
+ * 功能描述:
+ * 1. 统一管理实轴节点 z_k = k ln2 / t (k = 1..n) 上的反演算法，求解器只负责计算节点处的 Laplace 解。
+ * 2. Stehfest: 权重表在编译期 (constexpr) 生成，运行时不再重复计算阶乘；节点数按精度要求选择 (modelsolver01-06.h)。
+ * 3. 节点与反演公式同时提供 DualNumber 版本，参数灵敏度经反演求和按链式法则传播。
+ * 4. Laplace 解的代理网格: 对数时间序列相邻时间点的节点 z = k ln2 / t 大量重叠，可先在覆盖全部节点的
+ *    对数等间距 z 网格上计算 F(z)，再按 ln(z F(z)) 对 ln z 做 8 点 Lagrange 插值得到各节点的值。
+ */
+
+#ifndef LAPLACEINVERSION_H
+#define LAPLACEINVERSION_H
+
+#include "dualnumber.h"
+#include <vector>
+
+class LaplaceInversion
+{
+public:
+    static const int kMaxNodes = 20; // 双精度下更高阶的反演舍入误差过大
+
+    // 规范化节点数: 取偶数且不超过 kMaxNodes，奇数或过小时取 4
+    static int normalizedNodeCount(int nodes);
+
+    // 第 k 个节点 (k = 1..nodes)
+    static double node(int k, double t);
+    static DualNumber node(int k, const DualNumber& t);
+
+    // 由节点处的 Laplace 解 values[k-1] = F(z_k) 反演得到 f(t)，nodes 须已规范化
+    static double invert(int nodes, double t, const double* values);
+    static DualNumber invert(int nodes, const DualNumber& t, const DualNumber* values);
+
+    // Stehfest 权重表 (长度 nodes)
+    static const double* stehfestWeights(int nodes);
+
+private:
+    template <typename T>
+    static T invertStehfest(int nodes, const T& t, const T* values);
+};
+
+// Laplace 解的代理网格: [zMin, zMax] 上 (两侧各留出插值模板宽度) 每个对数周期 pointsPerDecade 个点
+class LaplaceSurrogateGrid
+{
+public:
+    static const int kOrder = 8; // Lagrange 插值点数
+
+    LaplaceSurrogateGrid(double zMin, double zMax, int pointsPerDecade);
+
+    int size() const { return m_size; }
+    double node(int j) const;
+
+    // values[j] = F(node(j))；存在非正或非有限值时无法在对数坐标插值，返回 false
+    bool setValues(const double* values);
+
+    // 插值得到 F(z)，z 须在 [zMin, zMax] 内
+    double evaluate(double z) const;
+
+private:
+    double m_u0;               // 首个网格点的 ln z
+    double m_step;             // 网格间距 (ln z)
+    int m_size;
+    std::vector<double> m_g;   // ln(z F(z))
+};
+
+#endif // LAPLACEINVERSION_H
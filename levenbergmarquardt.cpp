@@ -0,0 +1,204 @@
+/*
+ * 文件名: levenbergmarquardt.cpp
+ * 文件作用: 带盒约束的信赖域 Levenberg-Marquardt 最小二乘求解器实现
+ * 功能描述:
+ * 1. 每个试探步: 确定活动约束 -> 对自由变量的 [J; sqrt(λ)D] 做 QR 分解求步长 v
+ *    -> 投影到可行域并计算残差 -> 按实际/预测下降比更新 λ。
+ * 2. 接受的试探点残差直接作为新的当前残差；雅可比矩阵只在接受步长后重新计算
+ *    (或以 Broyden 公式更新)，被拒绝的步长只改变 λ，复用当前的 J 与对角尺度。
+ */
+
+#include "levenbergmarquardt.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+const double kMaxDamping = 1e16;    // λ 超过此值仍无法下降时认为已到局部极小
+const double kMinDamping = 1e-12;
+
+}
+
+LevenbergMarquardtSolver::LevenbergMarquardtSolver(const LevenbergMarquardtOptions& options)
+    : m_options(options)
+{
+}
+
+LevenbergMarquardtResult LevenbergMarquardtSolver::solve(const LeastSquaresProblem& problem, const Eigen::VectorXd& x0,
+                                                         const StepCallback& onStep) const
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    const int n = x0.size();
+    LevenbergMarquardtResult result;
+
+    Eigen::VectorXd lower = problem.lower.size() == n ? problem.lower : Eigen::VectorXd::Constant(n, -inf);
+    Eigen::VectorXd upper = problem.upper.size() == n ? problem.upper : Eigen::VectorXd::Constant(n, inf);
+    Eigen::VectorXd x = x0.cwiseMax(lower).cwiseMin(upper);
+    result.x = x;
+
+    // 1. 初始残差
+    Eigen::VectorXd r;
+    if (!problem.residuals(x, r)) {
+        result.aborted = true;
+        return result;
+    }
+    result.residualEvaluations = 1;
+    double f = r.squaredNorm();
+    const int m = r.size();
+    result.residuals = r;
+    result.sse = f;
+    result.damping = m_options.initialDamping;
+    if (onStep && !onStep(0, x, r)) {
+        result.aborted = true;
+        return result;
+    }
+    if (n == 0 || m == 0) {
+        result.converged = true;
+        return result;
+    }
+
+    Eigen::MatrixXd J;
+    Eigen::VectorXd scale2 = Eigen::VectorXd::Zero(n);  // Moré 对角尺度 D^2 (各列平方范数的历史最大值)
+    double lambda = m_options.initialDamping;
+    double nu = 2.0;
+    bool needJacobian = true;
+    bool jacobianFresh = false;     // 当前 J 为完整计算 (而非秩一更新) 所得
+    int updatesSinceRefresh = 0;
+
+    Eigen::VectorXd rTrial;
+    std::vector<int> freeVars;
+    freeVars.reserve(n);
+
+    while (result.iterations < m_options.maxIterations) {
+        if (f / m < m_options.mseTolerance) {
+            result.converged = true;
+            break;
+        }
+
+        // 2. 雅可比矩阵: 首次、接受步长后 (非 Broyden 模式)、或秩一更新次数达到上限时完整计算
+        if (needJacobian || (m_options.broydenUpdate && updatesSinceRefresh >= m_options.jacobianRefreshInterval)) {
+            if (!problem.jacobian(x, r, J) || J.rows() != m || J.cols() != n) {
+                result.aborted = true;
+                break;
+            }
+            result.jacobianEvaluations++;
+            // 模型在个别点上计算失败时的非有限导数按 0 处理 (该点不提供方向信息)
+            if (!J.allFinite()) J = J.unaryExpr([](double v) { return std::isfinite(v) ? v : 0.0; });
+            needJacobian = false;
+            jacobianFresh = true;
+            updatesSinceRefresh = 0;
+            scale2 = scale2.cwiseMax(J.colwise().squaredNorm().transpose());
+        }
+        const Eigen::VectorXd g = J.transpose() * r;
+
+        // 3. 活动约束: 位于边界且负梯度方向指向域外的变量本步固定
+        freeVars.clear();
+        double gradientNorm = 0.0;
+        for (int i = 0; i < n; ++i) {
+            bool blocked = (x(i) <= lower(i) && g(i) > 0.0) || (x(i) >= upper(i) && g(i) < 0.0);
+            if (blocked) continue;
+            freeVars.push_back(i);
+            gradientNorm = std::max(gradientNorm, std::abs(g(i)));
+        }
+        if (freeVars.empty() || gradientNorm < m_options.gradientTolerance) {
+            if (jacobianFresh) {
+                result.converged = true;
+                break;
+            }
+            needJacobian = true;
+            continue;
+        }
+
+        // 4. 阻尼步长: min |J_F v + r|^2 + λ |D_F v|^2，即增广矩阵 [J_F; sqrt(λ) D_F] 的最小二乘解
+        const int nf = static_cast<int>(freeVars.size());
+        Eigen::MatrixXd A = Eigen::MatrixXd::Zero(m + nf, nf);
+        Eigen::VectorXd d(nf);
+        for (int k = 0; k < nf; ++k) {
+            int i = freeVars[k];
+            A.col(k).head(m) = J.col(i);
+            d(k) = scale2(i) > 0.0 ? std::sqrt(scale2(i)) : 1.0;
+            A(m + k, k) = std::sqrt(lambda) * d(k);
+        }
+        Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr(A);
+        Eigen::VectorXd rhs = Eigen::VectorXd::Zero(m + nf);
+        rhs.head(m) = -r;
+        const Eigen::VectorXd vFree = qr.solve(rhs);
+
+        Eigen::VectorXd delta = Eigen::VectorXd::Zero(n);
+        for (int k = 0; k < nf; ++k) delta(freeVars[k]) = vFree(k);
+        result.iterations++;
+
+        // 5. 试探点投影回可行域，预测下降按投影后的实际步长 s 计算
+        double actual = -inf;
+        double predicted = 0.0;
+        Eigen::VectorXd s;
+        Eigen::VectorXd xTrial;
+        if (delta.allFinite()) {
+            xTrial = (x + delta).cwiseMax(lower).cwiseMin(upper);
+            s = xTrial - x;
+            if (!problem.residuals(xTrial, rTrial)) {
+                result.aborted = true;
+                break;
+            }
+            result.residualEvaluations++;
+            double fTrial = rTrial.size() == m ? rTrial.squaredNorm() : inf;
+            if (std::isfinite(fTrial)) actual = f - fTrial;
+            predicted = f - (r + J * s).squaredNorm();
+        }
+
+        if (actual > 0.0) {
+            // 6. 接受: 试探点残差即新的当前残差；按下降比 ρ 缩小 λ (Nielsen)
+            double rho = predicted > 0.0 ? actual / predicted : 0.0;
+            if (m_options.broydenUpdate) {
+                // 秩一更新 J += (y - J s) s^T / (s^T s)；线性模型预测偏离过大时下一步完整计算
+                double ss = s.squaredNorm();
+                if (rho >= m_options.minReductionRatio && ss > 1e-30) {
+                    J.noalias() += ((rTrial - r - J * s) / ss) * s.transpose();
+                    result.broydenUpdates++;
+                    updatesSinceRefresh++;
+                    jacobianFresh = false;
+                } else {
+                    needJacobian = true;
+                }
+            } else {
+                needJacobian = true;
+            }
+            double t = 2.0 * rho - 1.0;
+            lambda = std::max(kMinDamping, lambda * std::max(1.0 / 3.0, 1.0 - t * t * t));
+            nu = 2.0;
+
+            x = xTrial;
+            r.swap(rTrial);
+            f = r.squaredNorm();
+            result.acceptedSteps++;
+            if (onStep && !onStep(result.iterations, x, r)) {
+                result.aborted = true;
+                break;
+            }
+            double stepNorm = s.lpNorm<Eigen::Infinity>();
+            if (stepNorm <= m_options.stepTolerance * (x.lpNorm<Eigen::Infinity>() + m_options.stepTolerance)) {
+                result.converged = true;
+                break;
+            }
+        } else if (!jacobianFresh) {
+            // 秩一更新的 J 给出的步长被拒绝: λ 不变，用完整计算的 J 重试
+            needJacobian = true;
+        } else {
+            lambda *= nu;
+            nu *= 2.0;
+            if (lambda > kMaxDamping) {
+                result.converged = true;
+                break;
+            }
+        }
+    }
+
+    result.x = x;
+    result.residuals = r;
+    result.sse = f;
+    result.damping = lambda;
+    return result;
+}
@@ -0,0 +1,69 @@
+/*
+ * 文件名: levenbergmarquardt.h
+ * 文件作用: 带盒约束的信赖域 Levenberg-Marquardt 最小二乘求解器头文件
+ * 功能描述:
+ * 1. 与界面无关: 残差与雅可比矩阵通过回调提供，变量、残差与雅可比矩阵均为 Eigen 连续存储。
+ * 2. 阻尼步长由增广矩阵 [J; sqrt(λ)D] 的列主元 QR 分解求得，不显式构造 J^T J。
+ * 3. 信赖域按实际/预测下降比 (Nielsen 规则) 调整阻尼；被拒绝的步长不再重复整轮计算雅可比矩阵。
+ * 4. 盒约束: 位于边界且梯度指向域外的变量固定为活动约束，其余变量求步长后投影回可行域，
+ *    预测下降按投影后的实际步长计算。
+ * 5. 可选 Broyden 秩一更新: 接受步长后更新 J，按计划或预测变差时重新完整计算。
+ */
+
+#ifndef LEVENBERGMARQUARDT_H
+#define LEVENBERGMARQUARDT_H
+
+#include <Eigen/Dense>
+#include <functional>
+
+// 最小二乘问题: min |r(x)|^2，lower <= x <= upper
+struct LeastSquaresProblem {
+    // 计算残差，返回 false 表示计算失败或收到中止请求
+    std::function<bool(const Eigen::VectorXd& x, Eigen::VectorXd& r)> residuals;
+    // 计算雅可比矩阵 J = dr/dx (r 为 x 处的残差)，返回 false 表示中止
+    std::function<bool(const Eigen::VectorXd& x, const Eigen::VectorXd& r, Eigen::MatrixXd& J)> jacobian;
+    Eigen::VectorXd lower;
+    Eigen::VectorXd upper;
+};
+
+struct LevenbergMarquardtOptions {
+    int maxIterations = 100;            // 试探步总数上限 (含被拒绝的步长)
+    double mseTolerance = 0.0;          // 均方误差低于此值时结束
+    double stepTolerance = 1e-8;        // 相对步长低于此值时结束
+    double gradientTolerance = 1e-10;   // 自由变量梯度的无穷范数低于此值时结束
+    double initialDamping = 1e-2;       // 初始阻尼 λ0 (相对于对角尺度 D^2 = max diag(J^T J))
+    bool broydenUpdate = false;         // 接受步长后以秩一公式更新 J
+    int jacobianRefreshInterval = 5;    // Broyden 模式下连续秩一更新的最大次数
+    double minReductionRatio = 0.25;    // Broyden 模式下实际/预测下降比低于此值时重新计算 J
+};
+
+struct LevenbergMarquardtResult {
+    Eigen::VectorXd x;
+    Eigen::VectorXd residuals;
+    double sse = 0.0;
+    double damping = 0.0;           // 结束时的阻尼 λ (可作为续算的 initialDamping)
+    int iterations = 0;             // 试探步数
+    int acceptedSteps = 0;
+    int residualEvaluations = 0;
+    int jacobianEvaluations = 0;
+    int broydenUpdates = 0;
+    bool converged = false;         // 满足任一收敛判据
+    bool aborted = false;           // 回调返回 false
+};
+
+class LevenbergMarquardtSolver
+{
+public:
+    // 初始点及每次接受步长后调用 (试探步序号, 当前变量, 当前残差)，返回 false 时中止
+    using StepCallback = std::function<bool(int iteration, const Eigen::VectorXd& x, const Eigen::VectorXd& r)>;
+
+    explicit LevenbergMarquardtSolver(const LevenbergMarquardtOptions& options = LevenbergMarquardtOptions());
+
+    LevenbergMarquardtResult solve(const LeastSquaresProblem& problem, const Eigen::VectorXd& x0,
+                                   const StepCallback& onStep = StepCallback()) const;
+
+private:
+    LevenbergMarquardtOptions m_options;
+};
+
+#endif // LEVENBERGMARQUARDT_H
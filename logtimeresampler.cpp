@@ -0,0 +1,79 @@
+/*
+ * 文件名: logtimeresampler.cpp
+ * 文件作用: 观测数据对数时间抽稀实现
+ * 功能描述:
+ * 1. 窗口编号 floor(log10(t) * pointsPerDecade)，与数据是否按时间排序无关。
+ * 2. t <= 0 的点在全分辨率拟合中残差恒为 0，抽稀时直接舍弃。
+ */
+
+#include "logtimeresampler.h"
+
+#include <QMap>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+struct BinAccumulator {
+    int count = 0;
+    double sumLogT = 0.0;
+    int countP = 0;
+    double sumLogP = 0.0;
+    int countD = 0;
+    double sumLogD = 0.0;
+};
+
+}
+
+LogSampledData LogTimeResampler::resample(const QVector<double>& t, const QVector<double>& deltaP,
+                                          const QVector<double>& derivative, int pointsPerDecade)
+{
+    LogSampledData out;
+    int n = std::min(t.size(), deltaP.size());
+
+    if (pointsPerDecade <= 0) {
+        out.time = t.mid(0, n);
+        out.deltaP = deltaP.mid(0, n);
+        out.derivative = derivative.mid(0, n);
+        out.derivative.resize(n); // 导数缺失的点补 0 (残差为 0)
+        out.weightP.fill(1.0, n);
+        out.weightD.fill(1.0, n);
+        out.population.fill(1, n);
+        return out;
+    }
+
+    // 与原始残差的取值条件一致: 只有大于 1e-10 的值参与对数平均
+    QMap<int, BinAccumulator> bins;
+    int total = 0;
+    for (int i = 0; i < n; ++i) {
+        if (!(t[i] > 0.0)) continue;
+        double logT = std::log10(t[i]);
+        BinAccumulator& b = bins[(int)std::floor(logT * pointsPerDecade)];
+        b.count++;
+        b.sumLogT += logT;
+        if (deltaP[i] > 1e-10) { b.countP++; b.sumLogP += std::log(deltaP[i]); }
+        if (i < derivative.size() && derivative[i] > 1e-10) { b.countD++; b.sumLogD += std::log(derivative[i]); }
+        total++;
+    }
+    if (total == 0) return out;
+
+    int nBins = bins.size();
+    double scale = (double)nBins / total;
+    out.time.reserve(nBins);
+    out.deltaP.reserve(nBins);
+    out.derivative.reserve(nBins);
+    out.weightP.reserve(nBins);
+    out.weightD.reserve(nBins);
+    out.population.reserve(nBins);
+
+    for (auto it = bins.constBegin(); it != bins.constEnd(); ++it) {
+        const BinAccumulator& b = it.value();
+        out.time.append(std::pow(10.0, b.sumLogT / b.count));
+        out.deltaP.append(b.countP > 0 ? std::exp(b.sumLogP / b.countP) : 0.0);
+        out.derivative.append(b.countD > 0 ? std::exp(b.sumLogD / b.countD) : 0.0);
+        out.weightP.append(std::sqrt(b.countP * scale));
+        out.weightD.append(std::sqrt(b.countD * scale));
+        out.population.append(b.count);
+    }
+    return out;
+}
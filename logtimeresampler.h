@@ -0,0 +1,39 @@
+/*
+ * 文件名: logtimeresampler.h
+ * 文件作用: 观测数据对数时间抽稀头文件
+ * 功能描述:
+ * 1. 将高频采集的观测数据 (时间、压差、导数) 按对数时间等宽窗口分箱，每个对数周期保留指定点数。
+ * 2. 箱内取对数平均 (几何平均)，与拟合中的对数残差一致: 箱内各点残差平方和 = n * (箱平均残差)^2 + 常数。
+ * 3. 同时给出按箱内点数计算的残差权重，使抽稀后的目标函数与全分辨率目标函数保持同样的时间段权衡。
+ */
+
+#ifndef LOGTIMERESAMPLER_H
+#define LOGTIMERESAMPLER_H
+
+#include <QVector>
+
+// 抽稀后的拟合数据集
+struct LogSampledData {
+    QVector<double> time;          // 箱内时间几何平均
+    QVector<double> deltaP;        // 箱内压差几何平均 (无正值时为 0)
+    QVector<double> derivative;    // 箱内导数几何平均 (无正值时为 0)
+    QVector<double> weightP;       // 压差残差权重 sqrt(n_p * 箱数 / 总点数)
+    QVector<double> weightD;       // 导数残差权重
+    QVector<int> population;       // 箱内观测点数
+
+    int size() const { return time.size(); }
+    bool isEmpty() const { return time.isEmpty(); }
+};
+
+class LogTimeResampler
+{
+public:
+    /**
+     * @brief 对数时间分箱抽稀
+     * @param pointsPerDecade 每个对数周期的窗口数，<= 0 时不抽稀 (原样返回，权重为 1)
+     */
+    static LogSampledData resample(const QVector<double>& t, const QVector<double>& deltaP,
+                                   const QVector<double>& derivative, int pointsPerDecade);
+};
+
+#endif // LOGTIMERESAMPLER_H
@@ -22,6 +22,10 @@ ModelManager::ModelManager(QWidget* parent)
     : QObject(parent), m_mainWidget(nullptr), m_modelStack(nullptr)
     , m_currentModelType(Model_1)
 {
+    // 计算内核不依赖界面，构造时即可用于拟合和批量计算
+    for (int i = Model_1; i <= Model_6; ++i) {
+        m_solvers.append(ModelSolver01_06((ModelType)i));
+    }
 }
 
 ModelManager::~ModelManager() {}
@@ -181,23 +185,39 @@ QMap<QString, double> ModelManager::getDefaultParameters(ModelType type)
     return p;
 }
 
-ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime)
+ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime,
+                                                       const ModelSolverOptions& options) const
 {
     int index = (int)type;
-    if (index >= 0 && index < m_modelWidgets.size()) {
-        return m_modelWidgets[index]->calculateTheoreticalCurve(params, providedTime);
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index].calculateTheoreticalCurve(params, providedTime, options);
     }
     return ModelCurveData();
 }
 
-QVector<double> ModelManager::generateLogTimeSteps(int count, double startExp, double endExp) {
-    QVector<double> t;
-    t.reserve(count);
-    for (int i = 0; i < count; ++i) {
-        double exponent = startExp + (endExp - startExp) * i / (count - 1);
-        t.append(pow(10.0, exponent));
+ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const ModelParamVector& params, const QVector<double>& providedTime,
+                                                       const ModelSolverOptions& options) const
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index].calculateTheoreticalCurve(params, providedTime, options);
+    }
+    return ModelCurveData();
+}
+
+ModelCurveSensitivity ModelManager::calculateCurveSensitivities(ModelType type, const ModelParamVector& params, const QVector<int>& paramIds,
+                                                                const QVector<double>& providedTime,
+                                                                const ModelSolverOptions& options) const
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index].calculateCurveSensitivities(params, paramIds, providedTime, options);
     }
-    return t;
+    return ModelCurveSensitivity();
+}
+
+QVector<double> ModelManager::generateLogTimeSteps(int count, double startExp, double endExp) {
+    return ModelSolver01_06::generateLogTimeSteps(count, startExp, endExp);
 }
 
 void ModelManager::setObservedData(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d)
@@ -28,7 +28,15 @@ public:
     void initializeModels(QWidget* parentWidget);
     void switchToModel(ModelType modelType);
     static QString getModelTypeName(ModelType type);
-    ModelCurveData calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
+    // 理论曲线计算直接调用无界面的计算内核，线程安全，精度设置随调用传入
+    ModelCurveData calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>(),
+                                             const ModelSolverOptions& options = ModelSolverOptions()) const;
+    ModelCurveData calculateTheoreticalCurve(ModelType type, const ModelParamVector& params, const QVector<double>& providedTime = QVector<double>(),
+                                             const ModelSolverOptions& options = ModelSolverOptions()) const;
+    // 理论曲线及其对指定参数的解析偏导数 (前向自动微分)
+    ModelCurveSensitivity calculateCurveSensitivities(ModelType type, const ModelParamVector& params, const QVector<int>& paramIds,
+                                                      const QVector<double>& providedTime,
+                                                      const ModelSolverOptions& options = ModelSolverOptions()) const;
     QMap<QString, double> getDefaultParameters(ModelType type);
     void setHighPrecision(bool high);
     void updateAllModelsBasicParameters();
@@ -55,6 +63,7 @@ private:
     QWidget* m_mainWidget;
     QStackedWidget* m_modelStack;
     QVector<ModelWidget01_06*> m_modelWidgets;
+    QVector<ModelSolver01_06> m_solvers;     // 各模型计算内核 (与界面无关)
     ModelType m_currentModelType;
 
     QVector<double> m_cachedObsTime;
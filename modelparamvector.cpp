@@ -0,0 +1,84 @@
+/*
+ * 文件名: modelparamvector.cpp
+ * 文件作用: 模型参数定长向量实现
+ * 功能描述:
+ * 1. 定义参数名表与缺省值表 (与原 QMap::value 的缺省值一致)。
+ * 2. 实现与 QMap<QString,double> 之间的相互转换。
+ */
+
+#include "modelparamvector.h"
+
+namespace {
+
+struct ParamInfo {
+    const char* name;
+    double defaultValue;
+};
+
+// 顺序必须与 ModelParamId 保持一致
+const ParamInfo kParamTable[Param_Count] = {
+    { "phi",     0.05 },
+    { "h",       20.0 },
+    { "mu",      0.5 },
+    { "B",       1.05 },
+    { "Ct",      5e-4 },
+    { "q",       5.0 },
+    { "kf",      1e-3 },
+    { "km",      0.0 },
+    { "L",       1000.0 },
+    { "Lf",      0.0 },
+    { "LfD",     0.0 },
+    { "nf",      4.0 },
+    { "rmD",     0.0 },
+    { "reD",     0.0 },
+    { "omega1",  0.0 },
+    { "omega2",  0.0 },
+    { "lambda1", 0.0 },
+    { "gamaD",   0.0 },
+    { "cD",      0.0 },
+    { "S",       0.0 },
+    { "N",       4.0 }
+};
+
+}
+
+ModelParamVector::ModelParamVector()
+{
+    for (int i = 0; i < Param_Count; ++i) v[i] = kParamTable[i].defaultValue;
+}
+
+void ModelParamVector::updateDependent()
+{
+    if (v[Param_L] > 1e-9) v[Param_LfD] = v[Param_Lf] / v[Param_L];
+}
+
+ModelParamVector ModelParamVector::fromMap(const QMap<QString, double>& map)
+{
+    ModelParamVector p;
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+        int id = indexOf(it.key());
+        if (id >= 0) p.v[id] = it.value();
+    }
+    return p;
+}
+
+QMap<QString, double> ModelParamVector::toMap() const
+{
+    QMap<QString, double> map;
+    for (int i = 0; i < Param_Count; ++i) map.insert(QString::fromLatin1(kParamTable[i].name), v[i]);
+    return map;
+}
+
+int ModelParamVector::indexOf(const QString& name)
+{
+    for (int i = 0; i < Param_Count; ++i) {
+        if (name == QLatin1String(kParamTable[i].name)) return i;
+    }
+    return -1;
+}
+
+QString ModelParamVector::nameOf(int id)
+{
+    if (id < 0 || id >= Param_Count) return QString();
+    return QString::fromLatin1(kParamTable[id].name);
+}
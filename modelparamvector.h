@@ -0,0 +1,61 @@
+/*
+ * 文件名: modelparamvector.h
+ * 文件作用: 模型参数定长向量头文件
+ * 功能描述:
+ * 1. 以枚举下标访问的定长 double 数组表示一组模型参数，替代计算热点中的 QMap<QString,double>。
+ * 2. 拷贝为平凡内存拷贝，无堆分配、无字符串哈希和比较，可直接在拟合迭代中按值传递。
+ * 3. 仅在界面与项目文件边界处与参数名 (FitParameter / JSON) 相互转换。
+ */
+
+#ifndef MODELPARAMVECTOR_H
+#define MODELPARAMVECTOR_H
+
+#include <QMap>
+#include <QString>
+
+// 模型参数下标 (顺序即存储顺序)
+enum ModelParamId {
+    Param_phi = 0,   // 孔隙度
+    Param_h,         // 有效厚度
+    Param_mu,        // 粘度
+    Param_B,         // 体积系数
+    Param_Ct,        // 综合压缩系数
+    Param_q,         // 产量
+    Param_kf,        // 内区渗透率
+    Param_km,        // 外区渗透率
+    Param_L,         // 水平井长度
+    Param_Lf,        // 裂缝半长
+    Param_LfD,       // 无因次缝长 (Lf / L)
+    Param_nf,        // 裂缝条数
+    Param_rmD,       // 无因次复合半径
+    Param_reD,       // 无因次外边界半径
+    Param_omega1,    // 内区储容比
+    Param_omega2,    // 外区储容比
+    Param_lambda1,   // 窜流系数
+    Param_gamaD,     // 压敏系数
+    Param_cD,        // 无因次井储系数
+    Param_S,         // 表皮系数
+    Param_N,         // Stehfest 反演阶数
+    Param_Count
+};
+
+struct ModelParamVector
+{
+    double v[Param_Count];
+
+    ModelParamVector();
+
+    double& operator[](int id) { return v[id]; }
+    double operator[](int id) const { return v[id]; }
+
+    // 联动参数更新: LfD = Lf / L
+    void updateDependent();
+
+    // 边界转换: 参数名 <-> 下标
+    static ModelParamVector fromMap(const QMap<QString, double>& map);
+    QMap<QString, double> toMap() const;
+    static int indexOf(const QString& name);       // 未知参数返回 -1
+    static QString nameOf(int id);
+};
+
+#endif // MODELPARAMVECTOR_H
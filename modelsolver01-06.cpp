@@ -0,0 +1,1029 @@
+/*
+ * 文件名: modelsolver01-06.cpp
+ * 文件作用: 压裂水平井复合页岩油模型计算内核实现
+ * 功能描述:
+ * 1. 实现 6 种边界/井储组合模型的 Laplace 空间解与 Stehfest 数值反演。
+ * 2. 所有计算函数均为 const 或静态函数，不读写共享状态，支持多线程并发调用。
+ * 3. Laplace 解与线性方程组求解对 double / DualNumber 模板化，同一份代码给出曲线值与参数灵敏度。
+ * 4. 节点循环内的临时数组取自每个线程的 LaplaceWorkspace，加边方程组按裂缝条数选用定长上限或动态矩阵。
+ * 5. 模型类型在 calculatePD / calculateCurveSensitivities 入口经 dispatchModel 分派一次，节点循环内不再判断边界与井储类型。
+ */
+
+#include "modelsolver01-06.h"
+#include "pressurederivativecalculator.h"
+#include "gausskronrod.h"
+#include "besselintegral.h"
+#include "besselkernels.h"
+#include "laplaceinversion.h"
+#include "monotonecubic.h"
+#include "computeruntime.h"
+
+#include <Eigen/Dense>
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+ModelSolver01_06::ModelSolver01_06(ModelType type)
+    : m_type(type), m_curveCache(std::make_shared<DimensionlessCurveCache>())
+{
+}
+
+// 六种模型 = 外边界条件 (无限大 / 封闭 / 定压) x 井储类型 (变井储 / 恒定井储)
+template <typename Visitor>
+auto ModelSolver01_06::dispatchModel(ModelType type, Visitor&& visit)
+{
+    switch (type) {
+    case Model_2: return visit(ModelKernel<Boundary_Infinite, false>());
+    case Model_3: return visit(ModelKernel<Boundary_Closed, true>());
+    case Model_4: return visit(ModelKernel<Boundary_Closed, false>());
+    case Model_5: return visit(ModelKernel<Boundary_ConstantPressure, true>());
+    case Model_6: return visit(ModelKernel<Boundary_ConstantPressure, false>());
+    case Model_1:
+    default: return visit(ModelKernel<Boundary_Infinite, true>());
+    }
+}
+
+QVector<double> ModelSolver01_06::generateLogTimeSteps(int count, double startExp, double endExp) {
+    QVector<double> t;
+    t.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        double exponent = startExp + (endExp - startExp) * i / (count - 1);
+        t.append(pow(10.0, exponent));
+    }
+    return t;
+}
+
+int ModelSolver01_06::inversionNodesForTolerance(double tolerance)
+{
+    // 各节点数下六个模型默认参数压力曲线 (tD 1e-2 ~ 1e4) 的最大相对误差，以 N = 14 为参考；
+    // 更多节点时舍入误差抵消截断误差的改善，不再使用
+    static const struct { int nodes; double error; } kErrors[] = {
+        {4, 7.4e-2}, {6, 9.2e-3}, {8, 2.0e-3}, {10, 4.8e-4}, {12, 1.2e-4}, {14, 4e-5}
+    };
+    for (const auto& entry : kErrors) {
+        if (entry.error <= tolerance) return entry.nodes;
+    }
+    return 14;
+}
+
+ModelCurveData ModelSolver01_06::calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime,
+                                                           const ModelSolverOptions& options) const
+{
+    return calculateTheoreticalCurve(ModelParamVector::fromMap(params), providedTime, options);
+}
+
+ModelCurveData ModelSolver01_06::calculateTheoreticalCurve(const ModelParamVector& params, const QVector<double>& providedTime,
+                                                           const ModelSolverOptions& options) const
+{
+    QVector<double> tPoints = providedTime;
+    if (tPoints.isEmpty()) {
+        tPoints = generateLogTimeSteps(100, -3.0, 3.0);
+    }
+
+    double phi = params[Param_phi];
+    double mu = params[Param_mu];
+    double B = params[Param_B];
+    double Ct = params[Param_Ct];
+    double q = params[Param_q];
+    double h = params[Param_h];
+    double kf = params[Param_kf];
+    double L = params[Param_L];
+
+    QVector<double> tD_vec;
+    tD_vec.reserve(tPoints.size());
+    for(double t : tPoints) {
+        double val = 14.4 * kf * t / (phi * mu * Ct * pow(L, 2));
+        tD_vec.append(val);
+    }
+
+    QVector<double> PD_vec, Deriv_vec;
+    if (options.interpolate) calculatePDandDerivInterpolated(tD_vec, params, options, PD_vec, Deriv_vec);
+    else calculatePDandDeriv(tD_vec, params, options, PD_vec, Deriv_vec);
+
+    double factor = 1.842e-3 * q * mu * B / (kf * h);
+    QVector<double> finalP(tPoints.size()), finalDP(tPoints.size());
+
+    for(int i=0; i<tPoints.size(); ++i) {
+        finalP[i] = factor * PD_vec[i];
+        finalDP[i] = factor * Deriv_vec[i];
+    }
+
+    return std::make_tuple(tPoints, finalP, finalDP);
+}
+
+void ModelSolver01_06::calculatePDandDeriv(const QVector<double>& tD, const ModelParamVector& params,
+                                           const ModelSolverOptions& options,
+                                           QVector<double>& outPD, QVector<double>& outDeriv) const
+{
+    int numPoints = tD.size();
+    outPD = calculatePD(tD, params, options);
+    // Bourdet 导数在全部压力值得到后统一计算
+    if (numPoints > 2) outDeriv = PressureDerivativeCalculator::calculateBourdetDerivative(tD, outPD, 0.1);
+    else outDeriv.fill(0.0, numPoints);
+}
+
+namespace {
+
+// 反演节点数: 显式指定优先，否则高精度取参数 "N"，低精度固定 4 个节点
+int inversionNodeCount(const ModelParamVector& params, const ModelSolverOptions& options)
+{
+    int N = options.inversionNodes > 0 ? options.inversionNodes
+                                       : (options.highPrecision ? (int)params[Param_N] : 4);
+    return LaplaceInversion::normalizedNodeCount(N);
+}
+
+// 单个时间点的反演，gamaD 非零时再做压敏 (拟压力) 变换
+template <typename T>
+T invertPoint(int N, const T& t, const T* values, const T& gamaD)
+{
+    using std::log;
+    T pd = LaplaceInversion::invert(N, t, values);
+    if (std::abs(dualValue(gamaD)) > 1e-9) {
+        T arg = 1.0 - gamaD * pd;
+        if (arg > 1e-12) pd = -1.0 / gamaD * log(arg);
+    }
+    return pd;
+}
+
+// (时间点 x 反演节点) 网格上的 Laplace 解与反演，T 为 double 或 DualNumber
+template <typename T, typename LaplaceFunc>
+QVector<T> invertNodeGrid(const QVector<T>& tD, const T& gamaD, int N, LaplaceFunc laplace,
+                          const ModelSolverOptions& options)
+{
+    int numPoints = tD.size();
+    QVector<T> outPD(numPoints);
+
+    // 1. 展开 (时间点 x 反演节点) 计算网格，各节点的 Laplace 解相互独立
+    //    按存储顺序切分为连续小块交给计算运行时 (可嵌套在拟合的并行任务中)，同一时间点的节点落在同一块内
+    const int nodeCount = numPoints * N;
+    const int chunkSize = 16;
+    const int chunkCount = (nodeCount + chunkSize - 1) / chunkSize;
+    QVector<T> nodeValues(nodeCount, T(0.0));
+
+    auto evalChunk = [&](int chunk) {
+        if (options.cancel && options.cancel->load(std::memory_order_relaxed)) return;
+        int start = chunk * chunkSize;
+        int end = std::min(start + chunkSize, nodeCount);
+        for (int idx = start; idx < end; ++idx) {
+            const T& t = tD[idx / N];
+            if (t <= 1e-12) continue;
+            T z = LaplaceInversion::node(idx % N + 1, t);
+            T pf = laplace(z);
+            if (!std::isfinite(dualValue(pf))) pf = 0.0;
+            nodeValues[idx] = pf;
+        }
+    };
+
+    if (options.parallel && chunkCount > 1) {
+        ComputeRuntime::instance()->parallelFor(chunkCount, evalChunk);
+    } else {
+        for (int chunk = 0; chunk < chunkCount; ++chunk) evalChunk(chunk);
+    }
+    if (options.stats) {
+        long long evaluated = 0;
+        for (const T& t : tD) if (t > 1e-12) evaluated += N;
+        options.stats->laplaceEvaluations.fetch_add(evaluated, std::memory_order_relaxed);
+    }
+
+    // 2. 按固定顺序归约，结果与串行计算逐位一致
+    for (int k = 0; k < numPoints; ++k) {
+        const T& t = tD[k];
+        if (t <= 1e-12) { outPD[k] = 0.0; continue; }
+        outPD[k] = invertPoint(N, t, nodeValues.constData() + k * N, gamaD);
+    }
+    return outPD;
+}
+
+// 代理网格版本 (仅 double): 在覆盖全部节点的对数 z 网格上计算 Laplace 解 (与逐节点计算同样分块并行)，
+// 各节点的值由插值得到；网格点数不少于节点数 (节点重叠不足) 或网格上的值无法插值时返回 false，由调用方逐节点计算
+template <typename LaplaceFunc>
+bool invertSurrogateGrid(const QVector<double>& tD, double gamaD, int N, LaplaceFunc laplace,
+                         const ModelSolverOptions& options, QVector<double>& outPD)
+{
+    // 1. 节点范围
+    double tMin = 0.0, tMax = 0.0;
+    int validPoints = 0;
+    for (double t : tD) {
+        if (t <= 1e-12) continue;
+        tMin = validPoints == 0 ? t : std::min(tMin, t);
+        tMax = validPoints == 0 ? t : std::max(tMax, t);
+        ++validPoints;
+    }
+    if (validPoints == 0) return false;
+
+    // 反演对 F 误差的放大随 N 增大，节点数多于 8 时按比例加密
+    const int density = options.laplaceGridPointsPerDecade * std::max(N, 8) / 8;
+    LaplaceSurrogateGrid grid(LaplaceInversion::node(1, tMax), LaplaceInversion::node(N, tMin), density);
+    const int nodeCount = validPoints * N;
+    const int evalCount = grid.size();
+    if (evalCount >= nodeCount) return false;
+
+    // 2. 网格点分块并行计算
+    QVector<double> values(evalCount, 0.0);
+    const int chunkSize = 16;
+    const int chunkCount = (evalCount + chunkSize - 1) / chunkSize;
+    auto evalChunk = [&](int chunk) {
+        if (options.cancel && options.cancel->load(std::memory_order_relaxed)) return;
+        int end = std::min((chunk + 1) * chunkSize, evalCount);
+        for (int j = chunk * chunkSize; j < end; ++j) {
+            double pf = laplace(grid.node(j));
+            values[j] = std::isfinite(pf) ? pf : 0.0;
+        }
+    };
+    if (options.parallel && chunkCount > 1) {
+        ComputeRuntime::instance()->parallelFor(chunkCount, evalChunk);
+    } else {
+        for (int chunk = 0; chunk < chunkCount; ++chunk) evalChunk(chunk);
+    }
+    if (options.stats) {
+        options.stats->laplaceEvaluations.fetch_add(evalCount, std::memory_order_relaxed);
+    }
+    // 中途收到停止请求: 结果无效，不再逐节点重算
+    outPD.fill(0.0, tD.size());
+    if (options.cancel && options.cancel->load(std::memory_order_relaxed)) return true;
+    if (!grid.setValues(values.constData())) return false;
+    if (options.stats) {
+        options.stats->laplaceEvaluationsSaved.fetch_add(nodeCount - evalCount, std::memory_order_relaxed);
+    }
+
+    // 3. 各时间点的节点值 (插值) 与反演
+    double pf[LaplaceInversion::kMaxNodes];
+    for (int k = 0; k < tD.size(); ++k) {
+        double t = tD[k];
+        if (t <= 1e-12) continue;
+        for (int n = 0; n < N; ++n) pf[n] = grid.evaluate(LaplaceInversion::node(n + 1, t));
+        outPD[k] = invertPoint(N, t, pf, gamaD);
+    }
+    return true;
+}
+
+// 插值粗网格每个对数周期的初始点数与 [tMin, tMax] 上的初始点数
+int coarseGridPointsPerDecade(const ModelSolverOptions& options)
+{
+    return std::max(2, options.interpolationPointsPerDecade);
+}
+
+int coarseGridSize(double tMin, double tMax, int ppd)
+{
+    return std::max(2, (int)std::ceil((std::log10(tMax) - std::log10(tMin)) * ppd) + 1);
+}
+
+// 插值模式抽查插值误差的时间点数 (请求点不多于粗网格点数加抽查点数时直接计算)
+const int kInterpolationSpotChecks = 3;
+
+bool useCoarseGrid(int validPoints, double tMin, double tMax, int ppd)
+{
+    return validPoints > coarseGridSize(tMin, tMax, ppd) + kInterpolationSpotChecks
+           && std::log10(tMax) - std::log10(tMin) >= 1e-9;
+}
+
+// 覆盖 [tMin, tMax] 的自适应对数粗网格: 初始网格取在 tD = 10^(k/ppd) 的固定格点上，
+// 压力或导数的双对数二阶差分较大的区间插入对数中点，只对新增点求值。
+// evaluate(times) 返回各时间点的 pD (double 或 DualNumber)，细化判据只看函数值。
+// 网格位置不随请求范围平移: 参数变化使范围移动但不跨过格点时，重建的同一形状曲线网格不变，
+// 残差随参数的变化就是固定网格上插值曲线的变化，与灵敏度计算所求的导数一致
+template <typename T, typename Evaluate>
+void buildAdaptiveLogGrid(double tMin, double tMax, int ppd, Evaluate evaluate, QVector<double>& gridT, QVector<T>& gridPD)
+{
+    const double kCurvatureTol = 0.02; // 双对数坐标二阶差分阈值，超过则在相邻区间插入中点
+    const int kMaxRefineLevels = 2;
+
+    // 1. 初始粗网格 (端点向外取到格点，保证覆盖请求范围)
+    auto latticePoint = [ppd](int k) { return std::pow(10.0, (double)k / ppd); };
+    int lo = (int)std::floor(std::log10(tMin) * ppd), hi = (int)std::ceil(std::log10(tMax) * ppd);
+    while (latticePoint(lo) > tMin) --lo;
+    while (latticePoint(hi) < tMax) ++hi;
+    if (hi == lo) ++hi;
+    int nGrid = hi - lo + 1;
+    gridT.resize(nGrid);
+    for (int i = 0; i < nGrid; ++i) gridT[i] = latticePoint(lo + i);
+    gridPD = evaluate(gridT);
+
+    auto values = [](const QVector<T>& pd) {
+        QVector<double> v(pd.size());
+        for (int i = 0; i < pd.size(); ++i) v[i] = dualValue(pd[i]);
+        return v;
+    };
+    QVector<double> gridV = values(gridPD);
+    QVector<double> gridDeriv = PressureDerivativeCalculator::calculateBourdetDerivative(gridT, gridV, 0.1);
+
+    // 2. 曲率细化
+    auto logAbs = [](double v) { return std::log(std::max(std::abs(v), 1e-300)); };
+    for (int level = 0; level < kMaxRefineLevels; ++level) {
+        int m = gridT.size();
+        QVector<bool> refine(m - 1, false);
+        bool any = false;
+        for (int i = 1; i < m - 1; ++i) {
+            double cp = logAbs(gridV[i + 1]) - 2.0 * logAbs(gridV[i]) + logAbs(gridV[i - 1]);
+            double cd = logAbs(gridDeriv[i + 1]) - 2.0 * logAbs(gridDeriv[i]) + logAbs(gridDeriv[i - 1]);
+            if (std::abs(cp) > kCurvatureTol || std::abs(cd) > kCurvatureTol) {
+                refine[i - 1] = refine[i] = true;
+                any = true;
+            }
+        }
+        if (!any) break;
+
+        QVector<double> newT;
+        for (int i = 0; i < m - 1; ++i) {
+            if (refine[i]) newT.append(std::sqrt(gridT[i] * gridT[i + 1]));
+        }
+        QVector<T> newPD = evaluate(newT);
+
+        QVector<double> mergedT;
+        QVector<T> mergedPD;
+        mergedT.reserve(m + newT.size());
+        mergedPD.reserve(m + newT.size());
+        for (int i = 0, j = 0; i < m; ++i) {
+            mergedT.append(gridT[i]);
+            mergedPD.append(gridPD[i]);
+            if (i < m - 1 && refine[i]) { mergedT.append(newT[j]); mergedPD.append(newPD[j]); ++j; }
+        }
+        gridT = mergedT;
+        gridPD = mergedPD;
+        gridV = values(gridPD);
+        gridDeriv = PressureDerivativeCalculator::calculateBourdetDerivative(gridT, gridV, 0.1);
+    }
+}
+
+} // namespace
+
+QVector<double> ModelSolver01_06::calculatePD(const QVector<double>& tD, const ModelParamVector& params,
+                                              const ModelSolverOptions& options) const
+{
+    if (options.stats) options.stats->invertedPoints.fetch_add(tD.size(), std::memory_order_relaxed);
+    int N = inversionNodeCount(params, options);
+    const FractureGeometry geometry = fractureGeometry((int)params[Param_nf]);
+    ModelSolverStats* stats = options.stats;
+    return dispatchModel(m_type, [&](auto kernel) {
+        using Kernel = decltype(kernel);
+        auto laplace = [&](double z) {
+            return flaplace_composite<Kernel::boundary, Kernel::variableStorage>(z, params.v, geometry, stats);
+        };
+        QVector<double> outPD;
+        if (options.laplaceGridPointsPerDecade > 0 && invertSurrogateGrid(tD, params[Param_gamaD], N, laplace, options, outPD)) return outPD;
+        return invertNodeGrid(tD, params[Param_gamaD], N, laplace, options);
+    });
+}
+
+ModelCurveSensitivity ModelSolver01_06::calculateCurveSensitivities(const ModelParamVector& params, const QVector<int>& paramIds,
+                                                                    const QVector<double>& providedTime,
+                                                                    const ModelSolverOptions& options) const
+{
+    ModelCurveSensitivity result;
+    int nDir = paramIds.size();
+
+    // 0. 分配对偶方向: 比例参数只通过时间比例 a = 14.4 kf / (phi mu Ct L^2) 与压力系数 F = 1.842e-3 q mu B / (kf h)
+    //    进入曲线 p = F pD(a t)，故 ∂p/∂θ = p ∂lnF/∂θ + F (∂pD/∂ln a) ∂ln a/∂θ:
+    //    phi, mu, Ct 共用一个 ln a 方向，q, h, B 不需要方向；其余连续参数各占一个方向 (整数参数 nf, N 不占用)
+    auto isScaleParam = [](int id) {
+        return id == Param_phi || id == Param_mu || id == Param_Ct || id == Param_q || id == Param_h || id == Param_B;
+    };
+    QVector<int> direction(nDir, -1);
+    int nDual = 0;
+    bool needTimeScale = false;
+    for (int j = 0; j < nDir; ++j) {
+        int id = paramIds[j];
+        if (id < 0 || id >= Param_Count || id == Param_nf || id == Param_N) continue;
+        if (isScaleParam(id)) {
+            if (id == Param_phi || id == Param_mu || id == Param_Ct) needTimeScale = true;
+            continue;
+        }
+        direction[j] = nDual++;
+    }
+    const int timeScaleDir = needTimeScale ? nDual++ : -1;
+    if (nDual > DualNumber::kMaxDirections) return result;
+
+    result.time = providedTime;
+    if (result.time.isEmpty()) {
+        result.time = generateLogTimeSteps(100, -3.0, 3.0);
+    }
+    int numPoints = result.time.size();
+
+    // 1. 占用方向的参数提升为对偶数，其余参数保持常数
+    QVector<DualNumber> p(Param_Count);
+    bool lengthSeeded = false;
+    for (int id = 0; id < Param_Count; ++id) p[id] = params[id];
+    for (int j = 0; j < nDir; ++j) {
+        if (direction[j] < 0) continue;
+        int id = paramIds[j];
+        p[id] = DualNumber::variable(params[id], nDual, direction[j]);
+        if (id == Param_L || id == Param_Lf) lengthSeeded = true;
+    }
+    // 联动参数 LfD = Lf / L (与 ModelParamVector::updateDependent 一致)
+    if (lengthSeeded && params[Param_L] > 1e-9) p[Param_LfD] = p[Param_Lf] / p[Param_L];
+
+    // 2. 无因次时间: tD = 14.4 kf t / (phi mu Ct L^2)，对 kf, L 的导数由时间比例系数传播；
+    //    再乘以 exp(ε) (ε 为 ln a 方向)，该方向的导数即 ∂pD/∂ln a
+    DualNumber timeScale = 14.4 * p[Param_kf] / (p[Param_phi] * p[Param_mu] * p[Param_Ct] * p[Param_L] * p[Param_L]);
+    if (timeScaleDir >= 0) timeScale = timeScale * DualNumber::variable(1.0, nDual, timeScaleDir);
+    QVector<DualNumber> tD(numPoints);
+    for (int i = 0; i < numPoints; ++i) tD[i] = timeScale * result.time[i];
+
+    // 3. 对偶数 Laplace 解与反演 (与 calculatePD 相同的节点网格与并行调度)。
+    //    插值模式下与 calculateTheoreticalCurve 使用同一条无因次曲线: 缓存命中时取其网格，否则按相同规则新建并放入缓存；
+    //    在该网格上计算对偶数 pD，再以相同的插值方式插值到请求的 tD (tD 携带时间比例的导数)，
+    //    各方向导数就是残差所用插值曲线的导数
+    ModelSolverStats* stats = options.stats;
+    const DualNumber* pv = p.constData();
+    int N = inversionNodeCount(params, options);
+    const FractureGeometry geometry = fractureGeometry((int)params[Param_nf]);
+
+    int validPoints = 0;
+    double tMin = 0.0, tMax = 0.0;
+    for (int i = 0; i < numPoints; ++i) {
+        double t = tD[i].v;
+        if (t <= 1e-12) continue;
+        tMin = validPoints == 0 ? t : std::min(tMin, t);
+        tMax = validPoints == 0 ? t : std::max(tMax, t);
+        ++validPoints;
+    }
+    std::shared_ptr<const DimensionlessCurve> curve;
+    double gridMin = 0.0, gridMax = 0.0;
+    const bool coarse = options.interpolate && validPoints > 0
+                        && findInterpolationCurve(params, options, validPoints, tMin, tMax, curve, gridMin, gridMax);
+
+    QVector<DualNumber> PD = dispatchModel(m_type, [&](auto kernel) {
+        using Kernel = decltype(kernel);
+        auto laplace = [&](const DualNumber& z) {
+            return flaplace_composite<Kernel::boundary, Kernel::variableStorage>(z, pv, geometry, stats);
+        };
+        auto invertAt = [&](const QVector<DualNumber>& times) {
+            if (stats) stats->invertedPoints.fetch_add(times.size(), std::memory_order_relaxed);
+            return invertNodeGrid(times, p[Param_gamaD], N, laplace, options);
+        };
+        if (!coarse) return invertAt(tD);
+
+        // 网格点的无因次时间是常数，对偶分量只含形状参数的导数
+        auto invertGrid = [&](const QVector<double>& times) {
+            QVector<DualNumber> gridTD(times.size());
+            for (int i = 0; i < times.size(); ++i) gridTD[i] = times[i];
+            return invertAt(gridTD);
+        };
+        QVector<DualNumber> gridPD;
+        if (curve) {
+            gridPD = invertGrid(curve->gridT());
+        } else {
+            QVector<double> gridT;
+            buildAdaptiveLogGrid(gridMin, gridMax, coarseGridPointsPerDecade(options), invertGrid, gridT, gridPD);
+            QVector<double> gridV(gridPD.size());
+            for (int i = 0; i < gridPD.size(); ++i) gridV[i] = gridPD[i].v;
+            curve = std::make_shared<const DimensionlessCurve>(gridT, gridV);
+            if (!(options.cancel && options.cancel->load(std::memory_order_relaxed))) {
+                m_curveCache->insert(DimensionlessCurveKey::fromParams(params, N, coarseGridPointsPerDecade(options)), curve);
+            }
+        }
+        return curve->evaluate(gridPD, tD);
+    });
+
+    // 4. Bourdet 导数对压力是线性的，且时间整体缩放不改变对数间距，
+    //    因此各方向分量分别求导；最后取绝对值的一步按函数值的符号传播
+    DualNumber factor = 1.842e-3 * p[Param_q] * p[Param_mu] * p[Param_B] / (p[Param_kf] * p[Param_h]);
+    QVector<double> tDv(numPoints), column(numPoints);
+    for (int i = 0; i < numPoints; ++i) { tDv[i] = tD[i].v; column[i] = PD[i].v; }
+    auto signedDerivative = [&](const QVector<double>& values) {
+        if (numPoints > 2) return PressureDerivativeCalculator::calculateBourdetDerivative(tDv, values, 0.1, false);
+        return QVector<double>(numPoints, 0.0);
+    };
+    QVector<double> deriv = signedDerivative(column);
+
+    result.pressure.resize(numPoints);
+    result.derivative.resize(numPoints);
+    for (int i = 0; i < numPoints; ++i) {
+        result.pressure[i] = factor.v * PD[i].v;
+        result.derivative[i] = factor.v * std::abs(deriv[i]);
+    }
+
+    // 比例参数的 ∂ln a/∂θ 与 ∂lnF/∂θ
+    auto scaleSlopes = [&](int id, double& dLnA, double& dLnF) {
+        double value = params[id];
+        dLnA = 0.0;
+        dLnF = 0.0;
+        if (id == Param_phi || id == Param_Ct) dLnA = -1.0 / value;
+        else if (id == Param_mu) { dLnA = -1.0 / value; dLnF = 1.0 / value; }
+        else if (id == Param_q || id == Param_B) dLnF = 1.0 / value;
+        else if (id == Param_h) dLnF = -1.0 / value;
+    };
+
+    result.dPressure.resize(nDir);
+    result.dDerivative.resize(nDir);
+    for (int j = 0; j < nDir; ++j) {
+        int id = paramIds[j];
+        double dFactor = 0.0;
+        if (direction[j] >= 0) {
+            for (int i = 0; i < numPoints; ++i) column[i] = PD[i].derivative(direction[j]);
+            dFactor = factor.derivative(direction[j]);
+        } else if (id >= 0 && id < Param_Count && isScaleParam(id)) {
+            double dLnA, dLnF;
+            scaleSlopes(id, dLnA, dLnF);
+            for (int i = 0; i < numPoints; ++i) column[i] = timeScaleDir >= 0 ? dLnA * PD[i].derivative(timeScaleDir) : 0.0;
+            dFactor = factor.v * dLnF;
+        } else {
+            column.fill(0.0);
+        }
+        QVector<double> derivJ = signedDerivative(column);
+        QVector<double>& dP = result.dPressure[j];
+        QVector<double>& dD = result.dDerivative[j];
+        dP.resize(numPoints);
+        dD.resize(numPoints);
+        for (int i = 0; i < numPoints; ++i) {
+            dP[i] = dFactor * PD[i].v + factor.v * column[i];
+            double sign = deriv[i] < 0.0 ? -1.0 : 1.0;
+            dD[i] = sign * (dFactor * deriv[i] + factor.v * derivJ[i]);
+        }
+    }
+    return result;
+}
+
+// 插值模式: 自适应对数粗网格反演 + 双对数单调三次插值 (压力)，导数由插值压力计算
+// 粗网格上的无因次曲线按形状参数缓存，只有比例参数变化时直接插值
+void ModelSolver01_06::calculatePDandDerivInterpolated(const QVector<double>& tD, const ModelParamVector& params,
+                                                       const ModelSolverOptions& options,
+                                                       QVector<double>& outPD, QVector<double>& outDeriv) const
+{
+    int numPoints = tD.size();
+    QVector<int> valid;
+    double tMin = 0.0, tMax = 0.0;
+    for (int k = 0; k < numPoints; ++k) {
+        double t = tD[k];
+        if (t <= 1e-12) continue;
+        if (valid.isEmpty()) { tMin = t; tMax = t; }
+        else { tMin = std::min(tMin, t); tMax = std::max(tMax, t); }
+        valid.append(k);
+    }
+    if (valid.isEmpty()) {
+        calculatePDandDeriv(tD, params, options, outPD, outDeriv);
+        return;
+    }
+
+    // 1. 形状参数与反演设置相同、缓存范围覆盖请求范围时直接使用缓存曲线
+    std::shared_ptr<const DimensionlessCurve> curve;
+    double gridMin = 0.0, gridMax = 0.0;
+    if (!findInterpolationCurve(params, options, valid.size(), tMin, tMax, curve, gridMin, gridMax)) {
+        calculatePDandDeriv(tD, params, options, outPD, outDeriv);
+        return;
+    }
+    if (curve) {
+        if (options.stats) options.stats->shapeCacheHits.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        DimensionlessCurveKey key = DimensionlessCurveKey::fromParams(params, inversionNodeCount(params, options),
+                                                                      coarseGridPointsPerDecade(options));
+        curve = buildDimensionlessCurve(gridMin, gridMax, params, options);
+        // 计算中途收到停止请求时网格不完整，不放入缓存
+        if (!(options.cancel && options.cancel->load(std::memory_order_relaxed))) m_curveCache->insert(key, curve);
+    }
+
+    // 2. 压力插值
+    outPD.fill(0.0, numPoints);
+    for (int k : valid) outPD[k] = curve->evaluate(tD[k]);
+
+    // 导数与直接计算路径一致: 在请求时间序列上对 (插值) 压力做 Bourdet 导数
+    if (numPoints > 2) outDeriv = PressureDerivativeCalculator::calculateBourdetDerivative(tD, outPD, 0.1);
+    else outDeriv.fill(0.0, numPoints);
+
+    // 3. 抽查: 在若干请求时间处直接反演，给出插值误差估计
+    if (options.stats) {
+        QVector<double> checkT;
+        QVector<int> checkIdx;
+        for (int c = 1; c <= kInterpolationSpotChecks; ++c) {
+            int k = valid[(int)((long long)valid.size() * c / (kInterpolationSpotChecks + 1))];
+            checkIdx.append(k);
+            checkT.append(tD[k]);
+        }
+        QVector<double> checkPD = calculatePD(checkT, params, options);
+        double err = 0.0;
+        for (int c = 0; c < checkT.size(); ++c) {
+            if (std::abs(checkPD[c]) > 1e-300) err = std::max(err, std::abs(outPD[checkIdx[c]] - checkPD[c]) / std::abs(checkPD[c]));
+        }
+        options.stats->interpolationError.store(err, std::memory_order_relaxed);
+    }
+}
+
+// 缓存中同一形状的曲线覆盖请求范围时由 curve 返回；否则 curve 为空，[gridMin, gridMax] 为新建曲线的范围。
+// 未命中且请求点不多于粗网格点时返回 false (直接计算)
+bool ModelSolver01_06::findInterpolationCurve(const ModelParamVector& params, const ModelSolverOptions& options,
+                                              int validPoints, double tMin, double tMax,
+                                              std::shared_ptr<const DimensionlessCurve>& curve,
+                                              double& gridMin, double& gridMax) const
+{
+    const double kShiftMargin = 0.5; // 缓存曲线范围不足时向两侧多留出的对数周期
+
+    int ppd = coarseGridPointsPerDecade(options);
+    curve = m_curveCache->find(DimensionlessCurveKey::fromParams(params, inversionNodeCount(params, options), ppd));
+    if (curve && curve->covers(tMin, tMax)) return true;
+    if (!useCoarseGrid(validPoints, tMin, tMax, ppd)) {
+        curve.reset();
+        return false;
+    }
+    // 同一形状只是范围不足 (比例参数变化使曲线平移出缓存范围): 在合并范围两侧留出余量，后续小幅平移仍可命中
+    gridMin = tMin;
+    gridMax = tMax;
+    if (curve) {
+        gridMin = std::pow(10.0, std::log10(std::min(tMin, curve->tMin())) - kShiftMargin);
+        gridMax = std::pow(10.0, std::log10(std::max(tMax, curve->tMax())) + kShiftMargin);
+        curve.reset();
+    }
+    return true;
+}
+
+std::shared_ptr<const DimensionlessCurve> ModelSolver01_06::buildDimensionlessCurve(double tMin, double tMax, const ModelParamVector& params,
+                                                                                     const ModelSolverOptions& options) const
+{
+    QVector<double> gridT, gridPD;
+    buildAdaptiveLogGrid(tMin, tMax, coarseGridPointsPerDecade(options),
+                         [&](const QVector<double>& times) { return calculatePD(times, params, options); }, gridT, gridPD);
+    return std::make_shared<const DimensionlessCurve>(gridT, gridPD);
+}
+
+namespace {
+
+// 一组自变量处的 K0, K1, I0e, I1e (n <= 3)，double 版本直接调用批量内核
+void besselSet(const double* x, int n, double* k0, double* k1, double* i0e, double* i1e)
+{
+    BesselKernels::k0(x, k0, n);
+    BesselKernels::k1(x, k1, n);
+    BesselKernels::i0e(x, i0e, n);
+    BesselKernels::i1e(x, i1e, n);
+}
+
+// DualNumber 版本: 函数值仍由批量内核计算，导数按 (x > 0)
+// K0' = -K1, K1' = -K0 - K1/x, I0e' = I1e - I0e, I1e' = I0e - I1e/x - I1e 传播
+void besselSet(const DualNumber* x, int n, DualNumber* k0, DualNumber* k1, DualNumber* i0e, DualNumber* i1e)
+{
+    double xv[3], k0v[3], k1v[3], i0v[3], i1v[3];
+    for (int i = 0; i < n; ++i) xv[i] = x[i].v;
+    besselSet(xv, n, k0v, k1v, i0v, i1v);
+    for (int i = 0; i < n; ++i) {
+        k0[i] = DualNumber::chain(k0v[i], x[i], -k1v[i]);
+        k1[i] = DualNumber::chain(k1v[i], x[i], -k0v[i] - k1v[i] / xv[i]);
+        i0e[i] = DualNumber::chain(i0v[i], x[i], i1v[i] - i0v[i]);
+        i1e[i] = DualNumber::chain(i1v[i], x[i], i0v[i] - i1v[i] / xv[i] - i1v[i]);
+    }
+}
+
+DualNumber besselK0(const DualNumber& x)
+{
+    return DualNumber::chain(BesselKernels::k0(x.v), x, -BesselKernels::k1(x.v));
+}
+
+DualNumber besselI0e(const DualNumber& x)
+{
+    double i0 = BesselKernels::i0e(x.v);
+    return DualNumber::chain(i0, x, BesselKernels::i1e(x.v) - i0);
+}
+
+// 单条裂缝影响积分 ∫_{-LfD}^{LfD} [K0(γ1 r) + Ac I0(γ1 r) e^{-γ1 rmD}] da，r 为到 (dx - a, dy) 的距离
+// 被积函数按子区间的 15 个积分节点成组调用批量 Bessel 内核
+double fractureIntegral(double gama1, double LfD, double Ac_prefactor, double arg_g1_rm,
+                        double dx, double dy, QuadratureStats* qs)
+{
+    double val;
+    if (dy == 0.0) {
+        // [优化] 同一水平线上: K0 部分 (含对角元零距离处的对数奇异) 用解析积分，
+        // 数值积分只处理光滑的 I0 修正项，通常一个 15 点区间即收敛
+        val = BesselIntegral::k0SegmentIntegral(gama1, dx - LfD, dx + LfD);
+        double maxExponent = gama1 * (std::abs(dx) + LfD) - arg_g1_rm;
+        if (maxExponent > -700.0) {
+            auto remainder = [&](const double* a, double* y, int n) {
+                double arg[15];
+                for (int i = 0; i < n; ++i) arg[i] = gama1 * std::abs(dx - a[i]);
+                BesselKernels::i0e(arg, y, n);
+                for (int i = 0; i < n; ++i) {
+                    double exponent = arg[i] - arg_g1_rm;
+                    y[i] = (exponent > -700.0) ? Ac_prefactor * y[i] * std::exp(exponent) : 0.0;
+                }
+            };
+            val += integrateGaussKronrodBatch(remainder, -LfD, LfD, 1e-5, 1e-10, 1024, qs);
+        }
+    } else {
+        auto integrand = [&](const double* a, double* y, int n) {
+            double arg[15], k0[15];
+            for (int i = 0; i < n; ++i) {
+                double dist = std::sqrt((dx - a[i]) * (dx - a[i]) + dy * dy);
+                arg[i] = std::max(gama1 * dist, 1e-10);
+            }
+            BesselKernels::k0(arg, k0, n);
+            BesselKernels::i0e(arg, y, n);
+            for (int i = 0; i < n; ++i) {
+                double exponent = arg[i] - arg_g1_rm;
+                double term2 = (exponent > -700.0) ? Ac_prefactor * y[i] * std::exp(exponent) : 0.0;
+                y[i] = k0[i] + term2;
+            }
+        };
+        val = integrateGaussKronrodBatch(integrand, -LfD, LfD, 1e-5, 1e-10, 1024, qs);
+    }
+    return val;
+}
+
+// DualNumber 版本: 积分限 ±LfD 随参数变化，代换 a = LfD * s 后在固定区间 s ∈ [-1, 1] 上积分；
+// K0 段积分的偏导数由解析式给出
+DualNumber fractureIntegral(const DualNumber& gama1, const DualNumber& LfD, const DualNumber& Ac_prefactor,
+                            const DualNumber& arg_g1_rm, double dx, double dy, QuadratureStats* qs)
+{
+    DualNumber val;
+    if (dy == 0.0) {
+        double lo = dx - LfD.v, hi = dx + LfD.v;
+        double dGamma, dLo, dHi;
+        BesselIntegral::k0SegmentIntegralPartials(gama1.v, lo, hi, dGamma, dLo, dHi);
+        val = DualNumber::chain(BesselIntegral::k0SegmentIntegral(gama1.v, lo, hi), gama1, dGamma, LfD, dHi - dLo);
+        double maxExponent = gama1.v * (std::abs(dx) + LfD.v) - arg_g1_rm.v;
+        if (maxExponent > -700.0) {
+            auto remainder = [&](double s) -> DualNumber {
+                DualNumber arg = gama1 * abs(dx - LfD * s);
+                DualNumber exponent = arg - arg_g1_rm;
+                if (exponent.v <= -700.0) return DualNumber(0.0);
+                return Ac_prefactor * besselI0e(arg) * exp(exponent) * LfD;
+            };
+            val += integrateGaussKronrod(remainder, -1.0, 1.0, 1e-5, 1e-10, 1024, qs);
+        }
+    } else {
+        auto integrand = [&](double s) -> DualNumber {
+            DualNumber u = dx - LfD * s;
+            DualNumber arg = gama1 * sqrt(u * u + dy * dy);
+            if (arg.v < 1e-10) arg = 1e-10;
+            DualNumber exponent = arg - arg_g1_rm;
+            DualNumber y = besselK0(arg);
+            if (exponent.v > -700.0) y += Ac_prefactor * besselI0e(arg) * exp(exponent);
+            return y * LfD;
+        };
+        val = integrateGaussKronrod(integrand, -1.0, 1.0, 1e-5, 1e-10, 1024, qs);
+    }
+    return val;
+}
+
+// 加边方程组使用定长上限矩阵 (栈上存储，不申请堆内存) 的阶数上限: 裂缝条数 + 1
+const int kMaxBorderedSize = 33;
+
+template <int MaxSize>
+using BorderedMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor, MaxSize, MaxSize>;
+template <int MaxSize>
+using BorderedVector = Eigen::Matrix<double, Eigen::Dynamic, 1, 0, MaxSize, 1>;
+
+// 加边方程组 A*x = e_n (A 为 size x size，按行存储) 的最后一个分量
+template <int MaxSize>
+double borderedSolutionImpl(const double* A, int size)
+{
+    BorderedMatrix<MaxSize> M = Eigen::Map<const BorderedMatrix<Eigen::Dynamic>>(A, size, size);
+    Eigen::FullPivLU<BorderedMatrix<MaxSize>> lu(M);
+    BorderedVector<MaxSize> b = BorderedVector<MaxSize>::Zero(size);
+    b(size - 1) = 1.0;
+    BorderedVector<MaxSize> x = lu.solve(b);
+    return x(size - 1);
+}
+
+// DualNumber 版本: 函数值矩阵只做一次 LU 分解，各方向导数由 A x' = -A' x 回代求得
+template <int MaxSize>
+DualNumber borderedSolutionImpl(const DualNumber* A, int size)
+{
+    BorderedMatrix<MaxSize> M(size, size);
+    int directions = 0;
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            M(i, j) = A[i * size + j].v;
+            directions = std::max(directions, A[i * size + j].n);
+        }
+    }
+    Eigen::FullPivLU<BorderedMatrix<MaxSize>> lu(M);
+    BorderedVector<MaxSize> b = BorderedVector<MaxSize>::Zero(size);
+    b(size - 1) = 1.0;
+    BorderedVector<MaxSize> x = lu.solve(b);
+
+    DualNumber r(x(size - 1));
+    r.n = directions;
+    BorderedVector<MaxSize> rhs(size), dx(size);
+    for (int k = 0; k < directions; ++k) {
+        for (int i = 0; i < size; ++i) {
+            double s = 0.0;
+            for (int j = 0; j < size; ++j) s += A[i * size + j].derivative(k) * x(j);
+            rhs(i) = -s;
+        }
+        dx = lu.solve(rhs);
+        r.d[k] = dx(size - 1);
+    }
+    return r;
+}
+
+// 常见裂缝条数使用定长上限矩阵，更多裂缝时退回动态矩阵
+template <typename T>
+T borderedSolution(const T* A, int size)
+{
+    if (size <= kMaxBorderedSize) return borderedSolutionImpl<kMaxBorderedSize>(A, size);
+    return borderedSolutionImpl<Eigen::Dynamic>(A, size);
+}
+
+// 每个线程复用的 Laplace 解工作区: 容量只增不减，同一组参数的后续节点不再申请内存
+template <typename T>
+struct LaplaceWorkspace {
+    std::vector<T> col, ones, y, toeplitzWork;   // Levinson 递推
+    std::vector<T> matrix;                       // 通用加边方程组 (按行存储)
+
+    static LaplaceWorkspace& local()
+    {
+        thread_local LaplaceWorkspace workspace;
+        return workspace;
+    }
+};
+
+} // namespace
+
+// 裂缝等间距分布在 [-0.9, 0.9] 的同一水平线上
+ModelSolver01_06::FractureGeometry ModelSolver01_06::fractureGeometry(int nf)
+{
+    FractureGeometry geometry;
+    geometry.nf = std::max(nf, 1);
+    geometry.xwD.resize(geometry.nf);
+    geometry.ywD.fill(0.0, geometry.nf);
+    if (geometry.nf == 1) { geometry.xwD[0] = 0.0; } else {
+        double start = -0.9; double end = 0.9; double step = (end - start) / (geometry.nf - 1);
+        for (int i = 0; i < geometry.nf; ++i) geometry.xwD[i] = start + i * step;
+    }
+    geometry.regular = isRegularFractureLayout(geometry.xwD, geometry.ywD);
+    return geometry;
+}
+
+template <ModelSolver01_06::BoundaryCondition Boundary, bool VariableStorage, typename T>
+T ModelSolver01_06::flaplace_composite(const T& z, const T* p, const FractureGeometry& geometry, ModelSolverStats* stats) const {
+    const T& kf = p[Param_kf];
+    const T& km = p[Param_km];
+    const T& LfD = p[Param_LfD];
+    const T& rmD = p[Param_rmD];
+    const T& reD = p[Param_reD];
+    const T& omga1 = p[Param_omega1];
+    const T& omga2 = p[Param_omega2];
+    const T& remda1 = p[Param_lambda1];
+    T M12 = kf / km;
+    const T& temp = omga2;
+    T fs1 = omga1 + remda1 * temp / (remda1 + z * temp);
+    T fs2 = M12 * temp;
+
+    T pf = PWD_composite<Boundary>(z, fs1, fs2, M12, LfD, rmD, reD, geometry, stats);
+
+    if constexpr (VariableStorage) {
+        const T& CD = p[Param_cD];
+        const T& S = p[Param_S];
+        if (CD > 1e-12 || std::abs(dualValue(S)) > 1e-12) {
+            pf = (z * pf + S) / (z + CD * z * z * (z * pf + S));
+        }
+    }
+
+    return pf;
+}
+
+template <ModelSolver01_06::BoundaryCondition Boundary, typename T>
+T ModelSolver01_06::PWD_composite(const T& z, const T& fs1, const T& fs2, const T& M12, const T& LfD, const T& rmD, const T& reD,
+                                  const FractureGeometry& geometry, ModelSolverStats* stats) const {
+    using std::sqrt;
+    using std::exp;
+    const int nf = geometry.nf;
+    const double* xwD = geometry.xwD.constData();
+    const double* ywD = geometry.ywD.constData();
+    LaplaceWorkspace<T>& ws = LaplaceWorkspace<T>::local();
+    T gama1 = sqrt(z * fs1);
+    T gama2 = sqrt(z * fs2);
+    T arg_g2_rm = gama2 * rmD;
+    T arg_g1_rm = gama1 * rmD;
+
+    // 界面与外边界处的 Bessel 函数成组计算: {gama2*rmD, gama1*rmD, gama2*reD}，无限大边界不计算外边界项
+    constexpr int nArgs = (Boundary == Boundary_Infinite) ? 2 : 3;
+    T args[3] = { arg_g2_rm, arg_g1_rm, T(0.0) };
+    if constexpr (Boundary != Boundary_Infinite) args[2] = gama2 * reD;
+    T k0v[3], k1v[3], i0v[3], i1v[3];
+    besselSet(args, nArgs, k0v, k1v, i0v, i1v);
+
+    const T& k0_g2 = k0v[0];
+    const T& k1_g2 = k1v[0];
+    const T& k0_g1 = k0v[1];
+    const T& k1_g1 = k1v[1];
+
+    // 外边界反射项: term1 = mAB_i0 + K0(gama2 rmD), term2 = mAB_i1 - K1(gama2 rmD)
+    T term1 = k0_g2;
+    T term2 = -k1_g2;
+
+    if constexpr (Boundary != Boundary_Infinite) {
+        const T& arg_re = args[2];
+        const T& i0_g2_s = i0v[0];
+        const T& i1_g2_s = i1v[0];
+
+        // 封闭边界取 K1(re)/I1(re)，定压边界取 -K0(re)/I0(re) (I 为指数缩放值，差值由 exp(arg_g2_rm - arg_re) 补回)
+        const T& i_re_s = (Boundary == Boundary_Closed) ? i1v[2] : i0v[2];
+        if (i_re_s > 1e-100) {
+            T decay = exp(arg_g2_rm - arg_re);
+            T term_mAB_i0, term_mAB_i1;
+            if constexpr (Boundary == Boundary_Closed) {
+                term_mAB_i0 = (k1v[2] / i_re_s) * i0_g2_s * decay;
+                term_mAB_i1 = (k1v[2] / i_re_s) * i1_g2_s * decay;
+            } else {
+                term_mAB_i0 = -(k0v[2] / i_re_s) * i0_g2_s * decay;
+                term_mAB_i1 = -(k0v[2] / i_re_s) * i1_g2_s * decay;
+            }
+            term1 = term_mAB_i0 + k0_g2;
+            term2 = term_mAB_i1 - k1_g2;
+        }
+    }
+
+    T Acup = M12 * gama1 * k1_g1 * term1 + gama2 * k0_g1 * term2;
+
+    const T& i1_g1_s = i1v[1];
+    const T& i0_g1_s = i0v[1];
+
+    T Acdown_scaled = M12 * gama1 * i1_g1_s * term1 - gama2 * i0_g1_s * term2;
+
+    if (std::abs(dualValue(Acdown_scaled)) < 1e-100) Acdown_scaled = 1e-100;
+
+    T Ac_prefactor = Acup / Acdown_scaled;
+
+    // 单条裂缝影响: 仅依赖于两条裂缝中心的相对位置 (dx, dy)
+    auto fractureInfluence = [&](double dx, double dy) -> T {
+        QuadratureStats qs;
+        T val = fractureIntegral(gama1, LfD, Ac_prefactor, arg_g1_rm, dx, dy, &qs);
+        if (stats) {
+            stats->integrals.fetch_add(1, std::memory_order_relaxed);
+            stats->integrandEvaluations.fetch_add(qs.evaluations, std::memory_order_relaxed);
+        }
+        return z * val / (M12 * z * 2.0 * LfD);
+    };
+
+    // [优化] 等间距且同一水平线上的裂缝: A(i,j) 只与 |i-j| 有关 (对称 Toeplitz 矩阵)
+    // 只需计算 nf 个不同偏移量的积分，并用 Levinson 递推求解加边方程组
+    if (geometry.regular) {
+        ws.col.resize(nf);
+        ws.y.resize(nf);
+        ws.toeplitzWork.resize(2 * nf);
+        ws.ones.assign(nf, T(1.0));
+        for (int k = 0; k < nf; ++k) ws.col[k] = fractureInfluence(xwD[k] - xwD[0], 0.0);
+
+        // 加边方程组 [T -1; z*1^T 0][q; p] = [0; 1] 等价于 T*y = 1, p = 1 / (z * sum(y))
+        if (solveSymmetricToeplitz(ws.col.data(), ws.ones.data(), nf, ws.y.data(), ws.toeplitzWork.data())) {
+            T sumY = 0.0;
+            for (int k = 0; k < nf; ++k) sumY += ws.y[k];
+            if (std::abs(dualValue(sumY)) > 1e-300) return 1.0 / (z * sumY);
+        }
+        // 递推失败 (主子式近似奇异) 时退回通用求解路径
+    }
+
+    int size = nf + 1;
+    ws.matrix.resize(size * size);
+    T* A_mat = ws.matrix.data();
+    for (int i = 0; i < nf; ++i) {
+        for (int j = 0; j < nf; ++j) {
+            A_mat[i * size + j] = fractureInfluence(xwD[i] - xwD[j], ywD[i] - ywD[j]);
+        }
+    }
+    for (int i = 0; i < nf; ++i) { A_mat[i * size + nf] = -1.0; A_mat[nf * size + i] = z; }
+    A_mat[nf * size + nf] = 0.0;
+
+    return borderedSolution(A_mat, size);
+}
+
+// 判断裂缝是否等间距分布在同一水平线上 (此时影响矩阵为对称 Toeplitz 矩阵)
+bool ModelSolver01_06::isRegularFractureLayout(const QVector<double>& xwD, const QVector<double>& ywD) {
+    int nf = xwD.size();
+    if (nf < 2 || ywD.size() != nf) return false;
+    double step = xwD[1] - xwD[0];
+    double tol = 1e-12 * std::max(1.0, std::abs(step));
+    for (int i = 0; i < nf; ++i) {
+        if (std::abs(ywD[i] - ywD[0]) > tol) return false;
+        if (i > 0 && std::abs((xwD[i] - xwD[i - 1]) - step) > tol) return false;
+    }
+    return true;
+}
+
+// Levinson 递推求解对称 Toeplitz 方程组 T*x = b，T(i,j) = col[|i-j|]，复杂度 O(n^2)
+// DualNumber 版本对递推本身求导，与函数值的计算顺序一致
+template <typename T>
+bool ModelSolver01_06::solveSymmetricToeplitz(const T* col, const T* b, int n, T* x, T* work) {
+    if (n == 0 || std::abs(dualValue(col[0])) < 1e-300) return false;
+
+    T* f = work;
+    T* fNew = work + n;
+    for (int i = 0; i < n; ++i) { f[i] = 0.0; fNew[i] = 0.0; x[i] = 0.0; }
+    f[0] = 1.0 / col[0];
+    x[0] = b[0] / col[0];
+
+    for (int k = 1; k < n; ++k) {
+        // 前向向量 f 满足 T_k*f = e_1，对称性保证后向向量即 f 的逆序
+        T eps = 0.0;
+        for (int i = 0; i < k; ++i) eps += col[k - i] * f[i];
+        T denom = 1.0 - eps * eps;
+        if (std::abs(dualValue(denom)) < 1e-14) return false;
+
+        for (int i = 0; i <= k; ++i) {
+            T fi = (i < k) ? f[i] : T(0.0);
+            T bi = (i > 0) ? f[k - i] : T(0.0);
+            fNew[i] = (fi - eps * bi) / denom;
+        }
+        for (int i = 0; i <= k; ++i) f[i] = fNew[i];
+
+        T ex = 0.0;
+        for (int i = 0; i < k; ++i) ex += col[k - i] * x[i];
+        T corr = b[k] - ex;
+        for (int i = 0; i <= k; ++i) x[i] += corr * f[k - i];
+    }
+
+    for (int i = 0; i < n; ++i) if (!std::isfinite(dualValue(x[i]))) return false;
+    return true;
+}
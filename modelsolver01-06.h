@@ -0,0 +1,179 @@
+/*
+ * 文件名: modelsolver01-06.h
+ * 文件作用: 压裂水平井复合页岩油模型计算内核头文件
+ * 功能描述:
+ * 1. 将 Laplace 空间解 (flaplace_composite / PWD_composite) 与 Stehfest 反演从界面类中剥离。
+ * 2. 求解器不依赖任何 QWidget，除无因次曲线缓存 (内部加锁) 外不保存可变状态，可在任意线程中并发调用。
+ * 3. 精度等求解设置通过 ModelSolverOptions 逐次传入，界面、拟合与批处理互不干扰。
+ * 4. Laplace 反演算法与节点数可逐次选择 (见 laplaceinversion.h)。
+ * 5. 插值模式: 只在自适应对数时间粗网格上反演，再以双对数单调三次插值得到请求时间处的值。
+ * 6. 参数灵敏度: Laplace 解、Bessel 函数、裂缝积分与反演求和对 double / DualNumber 模板化，
+ *    一次前向自动微分计算同时得到理论曲线及其对各拟合参数的解析偏导数。
+ * 7. 比例参数 (phi, mu, Ct, q, h, B) 只使曲线在双对数坐标中平移: 插值模式按形状参数缓存无因次曲线
+ *    (dimensionlesscurvecache.h)，只有比例参数变化时不做反演；灵敏度计算中比例参数不占用独立的对偶方向。
+ * 8. Laplace 解去重 (拟合迭代启用，默认关闭): 对数时间序列各时间点的反演节点大量重叠，节点总数多于代理网格点数时
+ *    只在覆盖全部节点的对数 z 网格上计算 Laplace 解，各节点的值由插值得到 (见 LaplaceSurrogateGrid)；
+ *    插值误差远小于反演本身的误差。灵敏度计算不使用代理网格。
+ * 9. 节点循环不申请堆内存: 裂缝几何每组参数计算一次，Levinson 递推与加边方程组使用每个线程复用的工作区，
+ *    常见裂缝条数 (不超过 32 条) 的 LU 分解使用定长上限的矩阵 (在栈上)，Laplace 解直接调用而不经 std::function。
+ * 10. Laplace 解按外边界条件与井储类型模板化，六种模型组合在编译期实例化，每条曲线按模型类型分派一次；
+ *    无限大边界不计算任何与 reD 有关的 Bessel 函数与指数项。新增边界或井储类型只需增加模板分支与分派项。
+ */
+
+#ifndef MODELSOLVER01_06_H
+#define MODELSOLVER01_06_H
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include <tuple>
+#include <atomic>
+#include <memory>
+#include "modelparamvector.h"
+#include "laplaceinversion.h"
+#include "dualnumber.h"
+#include "dimensionlesscurvecache.h"
+
+// 类型定义: <时间, 压力, 导数>
+using ModelCurveData = std::tuple<QVector<double>, QVector<double>, QVector<double>>;
+
+// 理论曲线及其对参数的偏导数 (j 为求导参数在请求列表中的序号)
+struct ModelCurveSensitivity {
+    QVector<double> time;
+    QVector<double> pressure;
+    QVector<double> derivative;
+    QVector<QVector<double>> dPressure;     // dPressure[j][i] = ∂p(t_i) / ∂θ_j
+    QVector<QVector<double>> dDerivative;   // dDerivative[j][i] = ∂p'(t_i) / ∂θ_j
+};
+
+// 求解统计 (可选，由调用方持有，多线程并发累加)
+struct ModelSolverStats {
+    std::atomic<long long> integrals{0};             // 裂缝影响积分次数
+    std::atomic<long long> integrandEvaluations{0};  // 被积函数调用次数
+    std::atomic<long long> invertedPoints{0};        // 实际做 Laplace 反演的时间点数
+    std::atomic<double> interpolationError{0.0};     // 插值模式最近一次抽查的压力相对误差
+    std::atomic<long long> shapeCacheHits{0};        // 插值模式直接由无因次曲线缓存得到结果的次数
+    std::atomic<long long> laplaceEvaluations{0};    // Laplace 解 (flaplace_composite) 的计算次数
+    std::atomic<long long> laplaceEvaluationsSaved{0}; // 代理网格比逐节点计算少算的 Laplace 解次数
+};
+
+// 单次计算的求解设置 (随调用传入，求解器本身不保存)
+struct ModelSolverOptions {
+    bool highPrecision;     // 高精度: 反演节点数取参数 "N"; 低精度: 固定 4 个节点
+    bool parallel;          // 是否将 (时间点 x 反演节点) 网格分块并行计算 (计算运行时)
+    ModelSolverStats* stats; // 非空时累加积分开销统计
+    int inversionNodes;     // Stehfest 节点数，> 0 时覆盖 highPrecision 的选择 (可由 inversionNodesForTolerance 按精度选择)
+    bool interpolate;       // 插值模式: 请求时间点多于粗网格时只在粗网格上反演
+    int interpolationPointsPerDecade; // 插值粗网格每个对数周期的初始点数
+    const std::atomic<bool>* cancel; // 非空且置位时跳过尚未开始的节点计算 (结果无效，由调用方丢弃)
+    int laplaceGridPointsPerDecade; // Laplace 解代理网格每个对数周期的点数 (节点数 N > 8 时按 N/8 加密)，0 表示逐节点计算 (默认)
+
+    ModelSolverOptions(bool high = true, bool par = true)
+        : highPrecision(high), parallel(par), stats(nullptr),
+          inversionNodes(0),
+          interpolate(false), interpolationPointsPerDecade(15), cancel(nullptr),
+          laplaceGridPointsPerDecade(0) {}
+};
+
+class ModelSolver01_06
+{
+public:
+    enum ModelType {
+        Model_1 = 0, // 无限大 + 变井储
+        Model_2,     // 无限大 + 恒定井储
+        Model_3,     // 封闭边界 + 变井储
+        Model_4,     // 封闭边界 + 恒定井储
+        Model_5,     // 定压边界 + 变井储
+        Model_6      // 定压边界 + 恒定井储
+    };
+
+    explicit ModelSolver01_06(ModelType type = Model_1);
+
+    ModelType getModelType() const { return m_type; }
+
+    // 计算理论曲线 (线程安全，可并发调用)
+    ModelCurveData calculateTheoreticalCurve(const ModelParamVector& params,
+                                             const QVector<double>& providedTime = QVector<double>(),
+                                             const ModelSolverOptions& options = ModelSolverOptions()) const;
+    // 兼容接口: 参数名映射在入口处一次性转换为参数向量
+    ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params,
+                                             const QVector<double>& providedTime = QVector<double>(),
+                                             const ModelSolverOptions& options = ModelSolverOptions()) const;
+
+    // 计算理论曲线及其对 paramIds 中各参数的偏导数 (前向自动微分，线程安全)
+    // 整数参数 (nf, N) 的偏导数为 0；phi, mu, Ct 共用一个时间比例方向，q, h, B 不占用方向；
+    // 所需对偶方向数超过 DualNumber::kMaxDirections 时返回空结果
+    // options.interpolate 为真时与 calculateTheoreticalCurve 使用同一条无因次曲线 (同一网格、同一插值方式)，
+    // 导数为残差所用插值曲线的导数；该模式直接计算的请求 (点数不多于粗网格) 直接在请求时间点上反演
+    ModelCurveSensitivity calculateCurveSensitivities(const ModelParamVector& params, const QVector<int>& paramIds,
+                                                      const QVector<double>& providedTime,
+                                                      const ModelSolverOptions& options = ModelSolverOptions()) const;
+
+    // 生成对数等间距时间序列
+    static QVector<double> generateLogTimeSteps(int count, double startExp, double endExp);
+
+    // 理论曲线 (压力) 相对误差不超过 tolerance 的最少 Stehfest 节点数 (4 ~ 14，按六个模型的实测误差表选择)
+    static int inversionNodesForTolerance(double tolerance);
+
+private:
+    void calculatePDandDeriv(const QVector<double>& tD, const ModelParamVector& params,
+                             const ModelSolverOptions& options,
+                             QVector<double>& outPD, QVector<double>& outDeriv) const;
+    void calculatePDandDerivInterpolated(const QVector<double>& tD, const ModelParamVector& params,
+                                         const ModelSolverOptions& options,
+                                         QVector<double>& outPD, QVector<double>& outDeriv) const;
+    QVector<double> calculatePD(const QVector<double>& tD, const ModelParamVector& params,
+                                const ModelSolverOptions& options) const;
+    // 插值模式所用的无因次曲线: 缓存命中时由 curve 返回，否则给出新建曲线的范围；应直接计算时返回 false
+    bool findInterpolationCurve(const ModelParamVector& params, const ModelSolverOptions& options,
+                                int validPoints, double tMin, double tMax,
+                                std::shared_ptr<const DimensionlessCurve>& curve, double& gridMin, double& gridMax) const;
+    // 在覆盖 [tMin, tMax] 的自适应对数粗网格上反演得到无因次曲线 (曲率较大的区间插入中点)
+    std::shared_ptr<const DimensionlessCurve> buildDimensionlessCurve(double tMin, double tMax, const ModelParamVector& params,
+                                                                      const ModelSolverOptions& options) const;
+
+    // 裂缝几何: 只由裂缝条数决定，每组参数计算一次，各节点的 Laplace 解共用
+    struct FractureGeometry {
+        int nf = 1;
+        QVector<double> xwD, ywD;   // 裂缝中心的无因次坐标
+        bool regular = false;       // 等间距且在同一水平线上 (影响矩阵为对称 Toeplitz 矩阵)
+    };
+    static FractureGeometry fractureGeometry(int nf);
+
+    // 外边界条件 (Laplace 解的编译期模板参数)
+    enum BoundaryCondition {
+        Boundary_Infinite = 0,      // 无限大
+        Boundary_Closed,            // 封闭
+        Boundary_ConstantPressure   // 定压
+    };
+
+    // 模型组合标记: 外边界条件与井储类型 (true 为变井储，计入井储系数 cD 与表皮 S)
+    template <BoundaryCondition Boundary, bool VariableStorage>
+    struct ModelKernel {
+        static constexpr BoundaryCondition boundary = Boundary;
+        static constexpr bool variableStorage = VariableStorage;
+    };
+
+    // 按模型类型以对应的 ModelKernel 标记调用 visit (每条曲线分派一次)，返回 visit 的结果
+    template <typename Visitor>
+    static auto dispatchModel(ModelType type, Visitor&& visit);
+
+    // Laplace 空间解，T 为 double 或 DualNumber，p 按 ModelParamId 下标存放参数
+    template <BoundaryCondition Boundary, bool VariableStorage, typename T>
+    T flaplace_composite(const T& z, const T* p, const FractureGeometry& geometry, ModelSolverStats* stats) const;
+    template <BoundaryCondition Boundary, typename T>
+    T PWD_composite(const T& z, const T& fs1, const T& fs2, const T& M12, const T& LfD, const T& rmD, const T& reD,
+                    const FractureGeometry& geometry, ModelSolverStats* stats) const;
+
+    static bool isRegularFractureLayout(const QVector<double>& xwD, const QVector<double>& ywD);
+    // work 为 2n 个元素的工作区
+    template <typename T>
+    static bool solveSymmetricToeplitz(const T* col, const T* b, int n, T* x, T* work);
+
+
+private:
+    ModelType m_type;
+    std::shared_ptr<DimensionlessCurveCache> m_curveCache; // 插值模式的无因次曲线缓存 (拷贝的求解器共享同一缓存)
+};
+
+#endif // MODELSOLVER01_06_H
@@ -13,9 +13,6 @@
 #include "pressurederivativecalculator.h"
 #include "modelparameter.h"
 
-#include <Eigen/Dense>
-#include <boost/math/special_functions/bessel.hpp>
-
 #include <cmath>
 #include <algorithm>
 #include <QDebug>
@@ -26,14 +23,11 @@
 #include <QCoreApplication>
 #include <QSplitter>
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
 ModelWidget01_06::ModelWidget01_06(ModelType type, QWidget *parent)
     : QWidget(parent)
     , ui(new Ui::ModelWidget01_06)
     , m_type(type)
+    , m_solver(type)
     , m_highPrecision(true)
 {
     ui->setupUi(this);
@@ -381,222 +375,5 @@ void ModelWidget01_06::onExportData() {
 
 ModelCurveData ModelWidget01_06::calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime)
 {
-    QVector<double> tPoints = providedTime;
-    if (tPoints.isEmpty()) {
-        tPoints = ModelManager::generateLogTimeSteps(100, -3.0, 3.0);
-    }
-
-    double phi = params.value("phi", 0.05);
-    double mu = params.value("mu", 0.5);
-    double B = params.value("B", 1.05);
-    double Ct = params.value("Ct", 5e-4);
-    double q = params.value("q", 5.0);
-    double h = params.value("h", 20.0);
-    double kf = params.value("kf", 1e-3);
-    double L = params.value("L", 1000.0);
-
-    QVector<double> tD_vec;
-    tD_vec.reserve(tPoints.size());
-    for(double t : tPoints) {
-        double val = 14.4 * kf * t / (phi * mu * Ct * pow(L, 2));
-        tD_vec.append(val);
-    }
-
-    QVector<double> PD_vec, Deriv_vec;
-    auto func = std::bind(&ModelWidget01_06::flaplace_composite, this, std::placeholders::_1, std::placeholders::_2);
-    calculatePDandDeriv(tD_vec, params, func, PD_vec, Deriv_vec);
-
-    double factor = 1.842e-3 * q * mu * B / (kf * h);
-    QVector<double> finalP(tPoints.size()), finalDP(tPoints.size());
-
-    for(int i=0; i<tPoints.size(); ++i) {
-        finalP[i] = factor * PD_vec[i];
-        finalDP[i] = factor * Deriv_vec[i];
-    }
-
-    return std::make_tuple(tPoints, finalP, finalDP);
-}
-
-void ModelWidget01_06::calculatePDandDeriv(const QVector<double>& tD, const QMap<QString, double>& params,
-                                           std::function<double(double, const QMap<QString, double>&)> laplaceFunc,
-                                           QVector<double>& outPD, QVector<double>& outDeriv)
-{
-    int numPoints = tD.size();
-    outPD.resize(numPoints);
-    outDeriv.resize(numPoints);
-
-    int N_param = (int)params.value("N", 4);
-    int N = m_highPrecision ? N_param : 4;
-    if (N % 2 != 0) N = 4;
-    double ln2 = log(2.0);
-
-    double gamaD = params.value("gamaD", 0.0);
-
-    for (int k = 0; k < numPoints; ++k) {
-        double t = tD[k];
-        if (t <= 1e-12) { outPD[k] = 0; continue; }
-        double pd_val = 0.0;
-        for (int m = 1; m <= N; ++m) {
-            double z = m * ln2 / t;
-            double pf = laplaceFunc(z, params);
-            if (std::isnan(pf) || std::isinf(pf)) pf = 0.0;
-            pd_val += stefestCoefficient(m, N) * pf;
-        }
-        outPD[k] = pd_val * ln2 / t;
-
-        if (std::abs(gamaD) > 1e-9) {
-            double arg = 1.0 - gamaD * outPD[k];
-            if (arg > 1e-12) {
-                outPD[k] = -1.0 / gamaD * std::log(arg);
-            }
-        }
-    }
-    if (numPoints > 2) outDeriv = PressureDerivativeCalculator::calculateBourdetDerivative(tD, outPD, 0.1);
-    else outDeriv.fill(0.0);
-}
-
-double ModelWidget01_06::flaplace_composite(double z, const QMap<QString, double>& p) {
-    double kf = p.value("kf");
-    double km = p.value("km");
-    double LfD = p.value("LfD");
-    double rmD = p.value("rmD");
-    double reD = p.value("reD", 0.0);
-    double omga1 = p.value("omega1");
-    double omga2 = p.value("omega2");
-    double remda1 = p.value("lambda1");
-    int nf = (int)p.value("nf", 4); if(nf < 1) nf = 1;
-    double M12 = kf / km;
-    QVector<double> xwD;
-    if (nf == 1) { xwD.append(0.0); } else {
-        double start = -0.9; double end = 0.9; double step = (end - start) / (nf - 1);
-        for(int i=0; i<nf; ++i) xwD.append(start + i * step);
-    }
-    double temp = omga2;
-    double fs1 = omga1 + remda1 * temp / (remda1 + z * temp);
-    double fs2 = M12 * temp;
-
-    double pf = PWD_composite(z, fs1, fs2, M12, LfD, rmD, reD, nf, xwD, m_type);
-
-    bool hasStorage = (m_type == Model_1 || m_type == Model_3 || m_type == Model_5);
-    if (hasStorage) {
-        double CD = p.value("cD", 0.0);
-        double S = p.value("S", 0.0);
-        if (CD > 1e-12 || std::abs(S) > 1e-12) {
-            pf = (z * pf + S) / (z + CD * z * z * (z * pf + S));
-        }
-    }
-
-    return pf;
-}
-
-double ModelWidget01_06::PWD_composite(double z, double fs1, double fs2, double M12, double LfD, double rmD, double reD, int nf, const QVector<double>& xwD, ModelType type) {
-    using namespace boost::math;
-    QVector<double> ywD(nf, 0.0);
-    double gama1 = sqrt(z * fs1);
-    double gama2 = sqrt(z * fs2);
-    double arg_g2_rm = gama2 * rmD;
-    double arg_g1_rm = gama1 * rmD;
-
-    double k0_g2 = cyl_bessel_k(0, arg_g2_rm);
-    double k1_g2 = cyl_bessel_k(1, arg_g2_rm);
-    double k0_g1 = cyl_bessel_k(0, arg_g1_rm);
-    double k1_g1 = cyl_bessel_k(1, arg_g1_rm);
-
-    double term_mAB_i0 = 0.0;
-    double term_mAB_i1 = 0.0;
-
-    bool isInfinite = (type == Model_1 || type == Model_2);
-    bool isClosed = (type == Model_3 || type == Model_4);
-    bool isConstP = (type == Model_5 || type == Model_6);
-
-    if (!isInfinite) {
-        double arg_re = gama2 * reD;
-        double i1_re_s = scaled_besseli(1, arg_re);
-        double i0_re_s = scaled_besseli(0, arg_re);
-        double k1_re = cyl_bessel_k(1, arg_re);
-        double k0_re = cyl_bessel_k(0, arg_re);
-        double i0_g2_s = scaled_besseli(0, arg_g2_rm);
-        double i1_g2_s = scaled_besseli(1, arg_g2_rm);
-
-        if (isClosed) {
-            if (i1_re_s > 1e-100) {
-                term_mAB_i0 = (k1_re / i1_re_s) * i0_g2_s * std::exp(arg_g2_rm - arg_re);
-                term_mAB_i1 = (k1_re / i1_re_s) * i1_g2_s * std::exp(arg_g2_rm - arg_re);
-            }
-        } else if (isConstP) {
-            if (i0_re_s > 1e-100) {
-                term_mAB_i0 = -(k0_re / i0_re_s) * i0_g2_s * std::exp(arg_g2_rm - arg_re);
-                term_mAB_i1 = -(k0_re / i0_re_s) * i1_g2_s * std::exp(arg_g2_rm - arg_re);
-            }
-        }
-    }
-
-    double term1 = term_mAB_i0 + k0_g2;
-    double term2 = term_mAB_i1 - k1_g2;
-
-    double Acup = M12 * gama1 * k1_g1 * term1 + gama2 * k0_g1 * term2;
-
-    double i1_g1_s = scaled_besseli(1, arg_g1_rm);
-    double i0_g1_s = scaled_besseli(0, arg_g1_rm);
-
-    double Acdown_scaled = M12 * gama1 * i1_g1_s * term1 - gama2 * i0_g1_s * term2;
-
-    if (std::abs(Acdown_scaled) < 1e-100) Acdown_scaled = 1e-100;
-
-    double Ac_prefactor = Acup / Acdown_scaled;
-
-    int size = nf + 1;
-    Eigen::MatrixXd A_mat(size, size);
-    Eigen::VectorXd b_vec(size);
-    b_vec.setZero(); b_vec(nf) = 1.0;
-
-    for (int i = 0; i < nf; ++i) {
-        for (int j = 0; j < nf; ++j) {
-            auto integrand = [&](double a) -> double {
-                double dist = std::sqrt(std::pow(xwD[i] - xwD[j] - a, 2) + std::pow(ywD[i] - ywD[j], 2));
-                double arg_dist = gama1 * dist; if (arg_dist < 1e-10) arg_dist = 1e-10;
-
-                double term2 = 0.0;
-                double exponent = arg_dist - arg_g1_rm;
-                if (exponent > -700.0) {
-                    term2 = Ac_prefactor * scaled_besseli(0, arg_dist) * std::exp(exponent);
-                }
-                return cyl_bessel_k(0, arg_dist) + term2;
-            };
-            double val = adaptiveGauss(integrand, -LfD, LfD, 1e-5, 0, 10);
-            A_mat(i, j) = z * val / (M12 * z * 2 * LfD);
-        }
-    }
-    for (int i = 0; i < nf; ++i) { A_mat(i, nf) = -1.0; A_mat(nf, i) = z; }
-    A_mat(nf, nf) = 0.0;
-
-    return A_mat.fullPivLu().solve(b_vec)(nf);
-}
-
-double ModelWidget01_06::scaled_besseli(int v, double x) {
-    if (x < 0) x = -x;
-    if (x > 600.0) return 1.0 / std::sqrt(2.0 * M_PI * x);
-    return boost::math::cyl_bessel_i(v, x) * std::exp(-x);
-}
-double ModelWidget01_06::gauss15(std::function<double(double)> f, double a, double b) {
-    static const double X[] = { 0.0, 0.201194, 0.394151, 0.570972, 0.724418, 0.848207, 0.937299, 0.987993 };
-    static const double W[] = { 0.202578, 0.198431, 0.186161, 0.166269, 0.139571, 0.107159, 0.070366, 0.030753 };
-    double h = 0.5 * (b - a); double c = 0.5 * (a + b); double s = W[0] * f(c);
-    for (int i = 1; i < 8; ++i) { double dx = h * X[i]; s += W[i] * (f(c - dx) + f(c + dx)); }
-    return s * h;
-}
-double ModelWidget01_06::adaptiveGauss(std::function<double(double)> f, double a, double b, double eps, int depth, int maxDepth) {
-    double c = (a + b) / 2.0; double v1 = gauss15(f, a, b); double v2 = gauss15(f, a, c) + gauss15(f, c, b);
-    if (depth >= maxDepth || std::abs(v1 - v2) < 1e-10 * std::abs(v2) + eps) return v2;
-    return adaptiveGauss(f, a, c, eps/2, depth+1, maxDepth) + adaptiveGauss(f, c, b, eps/2, depth+1, maxDepth);
-}
-double ModelWidget01_06::stefestCoefficient(int i, int N) {
-    double s = 0.0; int k1 = (i + 1) / 2; int k2 = std::min(i, N / 2);
-    for (int k = k1; k <= k2; ++k) {
-        double num = pow(k, N / 2.0) * factorial(2 * k);
-        double den = factorial(N / 2 - k) * factorial(k) * factorial(k - 1) * factorial(i - k) * factorial(2 * k - i);
-        if(den!=0) s += num/den;
-    }
-    return ((i + N / 2) % 2 == 0 ? 1.0 : -1.0) * s;
+    return m_solver.calculateTheoreticalCurve(params, providedTime, ModelSolverOptions(m_highPrecision));
 }
-double ModelWidget01_06::factorial(int n) { if(n<=1)return 1; double r=1; for(int i=2;i<=n;++i)r*=i; return r; }
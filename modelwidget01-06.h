@@ -14,30 +14,26 @@
 #include <QMap>
 #include <QVector>
 #include <QColor>
-#include <tuple>
-#include <functional>
 #include "chartwidget.h"
+#include "modelsolver01-06.h"
 
 namespace Ui {
 class ModelWidget01_06;
 }
 
-// 类型定义: <时间, 压力, 导数>
-using ModelCurveData = std::tuple<QVector<double>, QVector<double>, QVector<double>>;
-
 class ModelWidget01_06 : public QWidget
 {
     Q_OBJECT
 
 public:
-    enum ModelType {
-        Model_1 = 0, // 无限大 + 变井储
-        Model_2,     // 无限大 + 恒定井储
-        Model_3,     // 封闭边界 + 变井储
-        Model_4,     // 封闭边界 + 恒定井储
-        Model_5,     // 定压边界 + 变井储
-        Model_6      // 定压边界 + 恒定井储
-    };
+    // 模型类型定义在计算内核中，此处保留原有访问方式
+    using ModelType = ModelSolver01_06::ModelType;
+    static const ModelType Model_1 = ModelSolver01_06::Model_1; // 无限大 + 变井储
+    static const ModelType Model_2 = ModelSolver01_06::Model_2; // 无限大 + 恒定井储
+    static const ModelType Model_3 = ModelSolver01_06::Model_3; // 封闭边界 + 变井储
+    static const ModelType Model_4 = ModelSolver01_06::Model_4; // 封闭边界 + 恒定井储
+    static const ModelType Model_5 = ModelSolver01_06::Model_5; // 定压边界 + 变井储
+    static const ModelType Model_6 = ModelSolver01_06::Model_6; // 定压边界 + 恒定井储
 
     explicit ModelWidget01_06(ModelType type, QWidget *parent = nullptr);
     ~ModelWidget01_06();
@@ -69,22 +65,10 @@ private:
     void setInputText(QLineEdit* edit, double value);
     void plotCurve(const ModelCurveData& data, const QString& name, QColor color, bool isSensitivity);
 
-    void calculatePDandDeriv(const QVector<double>& tD, const QMap<QString, double>& params,
-                             std::function<double(double, const QMap<QString, double>&)> laplaceFunc,
-                             QVector<double>& outPD, QVector<double>& outDeriv);
-
-    double flaplace_composite(double z, const QMap<QString, double>& p);
-    double PWD_composite(double z, double fs1, double fs2, double M12, double LfD, double rmD, double reD, int nf, const QVector<double>& xwD, ModelType type);
-
-    double scaled_besseli(int v, double x);
-    double gauss15(std::function<double(double)> f, double a, double b);
-    double adaptiveGauss(std::function<double(double)> f, double a, double b, double eps, int depth, int maxDepth);
-    double stefestCoefficient(int i, int N);
-    double factorial(int n);
-
 private:
     Ui::ModelWidget01_06 *ui;
     ModelType m_type;
+    ModelSolver01_06 m_solver;             // 计算内核 (无界面、可重入)
     bool m_highPrecision;
     QList<QColor> m_colorList;
     QVector<double> res_tD;
@@ -0,0 +1,78 @@
+/*
+ * 文件名: monotonecubic.cpp
+ * 文件作用: 单调保形三次插值实现
+ * 功能描述:
+ * 1. 内部节点切线取相邻割线斜率的加权调和平均 (Fritsch-Butland 形式)，相邻割线异号或为零时切线取 0。
+ * 2. 端点切线由单侧三点公式给出，并限制不超过 3 倍端区间割线斜率。
+ */
+
+#include "monotonecubic.h"
+#include "dualnumber.h"
+
+#include <algorithm>
+#include <cmath>
+
+template <typename T>
+MonotoneCubicInterpolator<T>::MonotoneCubicInterpolator(const QVector<double>& x, const QVector<T>& y)
+    : m_x(x), m_y(y)
+{
+    using std::abs;
+    int n = m_x.size();
+    m_slope.fill(T(0.0), n);
+    if (n < 2) return;
+
+    QVector<double> h(n - 1);
+    QVector<T> delta(n - 1);
+    for (int i = 0; i < n - 1; ++i) {
+        h[i] = m_x[i + 1] - m_x[i];
+        delta[i] = (m_y[i + 1] - m_y[i]) / h[i];
+    }
+
+    if (n == 2) {
+        m_slope[0] = m_slope[1] = delta[0];
+        return;
+    }
+
+    for (int i = 1; i < n - 1; ++i) {
+        if (delta[i - 1] * delta[i] <= 0.0) {
+            m_slope[i] = 0.0;
+        } else {
+            double w1 = 2.0 * h[i] + h[i - 1];
+            double w2 = h[i] + 2.0 * h[i - 1];
+            m_slope[i] = (w1 + w2) / (w1 / delta[i - 1] + w2 / delta[i]);
+        }
+    }
+
+    // 端点: 单侧三点公式 + 保形限制
+    auto endSlope = [](double h0, double h1, const T& d0, const T& d1) -> T {
+        T s = ((2.0 * h0 + h1) * d0 - h0 * d1) / (h0 + h1);
+        if (s * d0 <= 0.0) return 0.0;
+        if (d0 * d1 <= 0.0 && abs(s) > 3.0 * abs(d0)) return 3.0 * d0;
+        return s;
+    };
+    m_slope[0] = endSlope(h[0], h[1], delta[0], delta[1]);
+    m_slope[n - 1] = endSlope(h[n - 2], h[n - 3], delta[n - 2], delta[n - 3]);
+}
+
+template <typename T>
+T MonotoneCubicInterpolator<T>::evaluate(const T& xq) const
+{
+    int n = m_x.size();
+    if (n == 0) return 0.0;
+    if (n == 1) return m_y[0];
+    if (xq <= m_x[0]) return m_y[0] + m_slope[0] * (xq - m_x[0]);
+    if (xq >= m_x[n - 1]) return m_y[n - 1] + m_slope[n - 1] * (xq - m_x[n - 1]);
+
+    int i = int(std::upper_bound(m_x.constBegin(), m_x.constEnd(), dualValue(xq)) - m_x.constBegin()) - 1;
+    double h = m_x[i + 1] - m_x[i];
+    T s = (xq - m_x[i]) / h;
+    T s2 = s * s, s3 = s2 * s;
+    T h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    T h10 = s3 - 2.0 * s2 + s;
+    T h01 = -2.0 * s3 + 3.0 * s2;
+    T h11 = s3 - s2;
+    return h00 * m_y[i] + h10 * h * m_slope[i] + h01 * m_y[i + 1] + h11 * h * m_slope[i + 1];
+}
+
+template class MonotoneCubicInterpolator<double>;
+template class MonotoneCubicInterpolator<DualNumber>;
@@ -0,0 +1,33 @@
+/*
+ * 文件名: monotonecubic.h
+ * 文件作用: 单调保形三次插值头文件
+ * 功能描述:
+ * 1. 单调保形三次 Hermite 插值 (Fritsch-Butland 加权调和平均切线): 数据单调的区间内插值结果保持单调，不产生过冲。
+ * 2. 用于在双对数坐标下由粗网格上的理论曲线插值得到任意观测时间处的值。
+ * 3. 节点值与插值点的类型 T 为 double 或 DualNumber: 两者走相同的分支 (切线限制只比较函数值)，
+ *    T 为 DualNumber 时各方向导数就是同一条插值曲线对参数的导数。
+ */
+
+#ifndef MONOTONECUBIC_H
+#define MONOTONECUBIC_H
+
+#include <QVector>
+
+// 实现位于 monotonecubic.cpp，对 double 与 DualNumber 显式实例化
+template <typename T>
+class MonotoneCubicInterpolator
+{
+public:
+    // x 须严格递增，x 与 y 长度相同且至少 2 个点
+    MonotoneCubicInterpolator(const QVector<double>& x, const QVector<T>& y);
+
+    // 区间外按端点斜率线性外推
+    T evaluate(const T& xq) const;
+
+private:
+    QVector<double> m_x;
+    QVector<T> m_y;
+    QVector<T> m_slope; // 节点处的 Hermite 切线斜率
+};
+
+#endif // MONOTONECUBIC_H
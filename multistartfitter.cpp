@@ -0,0 +1,149 @@
+/*
+ * 文件名: multistartfitter.cpp
+ * 文件作用: 多起点全局拟合实现
+ * 功能描述:
+ * 1. 每轮的候选作为独立任务交给计算运行时并行续算，各任务只写入自己的候选，结果与调度顺序无关。
+ * 2. 候选在轮与轮之间保存解与阻尼，下一轮从上一轮的终点续算 (重新计算一次残差与雅可比矩阵)。
+ */
+
+#include "multistartfitter.h"
+#include "computeruntime.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+MultiStartFitter::MultiStartFitter(const MultiStartOptions& options)
+    : m_options(options)
+{
+}
+
+QVector<Eigen::VectorXd> MultiStartFitter::latinHypercube(const Eigen::VectorXd& lower, const Eigen::VectorXd& upper,
+                                                          int count, unsigned int seed)
+{
+    const int n = lower.size();
+    QVector<Eigen::VectorXd> samples(std::max(count, 0), Eigen::VectorXd(n));
+    if (count <= 0) return samples;
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<int> strata(count);
+    for (int dim = 0; dim < n; ++dim) {
+        // 每一维独立打乱层序，样本 k 落在第 strata[k] 层内的随机位置
+        std::iota(strata.begin(), strata.end(), 0);
+        std::shuffle(strata.begin(), strata.end(), rng);
+        for (int k = 0; k < count; ++k) {
+            double u = (strata[k] + uniform(rng)) / count;
+            samples[k](dim) = lower(dim) + u * (upper(dim) - lower(dim));
+        }
+    }
+    return samples;
+}
+
+QVector<MultiStartCandidate> MultiStartFitter::run(const LeastSquaresProblem& problem, const Eigen::VectorXd& x0,
+                                                   const Eigen::VectorXd& sampleLower, const Eigen::VectorXd& sampleUpper,
+                                                   const StageCallback& onStage, bool* aborted) const
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    const int n = x0.size();
+    const int budget = m_options.lm.maxIterations;
+    const int survivors = std::max(1, m_options.survivors);
+    if (aborted) *aborted = false;
+
+    // 1. 候选: 参数表当前值 + 拉丁超立方起点 (采样范围无效的维度固定为当前值)
+    Eigen::VectorXd lo = x0, hi = x0;
+    for (int i = 0; i < n; ++i) {
+        if (i < sampleLower.size() && i < sampleUpper.size() && std::isfinite(sampleLower(i))
+            && std::isfinite(sampleUpper(i)) && sampleLower(i) <= sampleUpper(i)) {
+            lo(i) = sampleLower(i);
+            hi(i) = sampleUpper(i);
+        }
+    }
+    QVector<Eigen::VectorXd> starts;
+    starts.append(x0);
+    starts += latinHypercube(lo, hi, m_options.starts, m_options.seed);
+
+    QVector<MultiStartCandidate> candidates(starts.size());
+    QVector<int> active;
+    for (int k = 0; k < starts.size(); ++k) {
+        MultiStartCandidate& c = candidates[k];
+        c.startIndex = k;
+        c.start = starts[k];
+        c.x = starts[k];
+        c.sse = inf;
+        c.mse = inf;
+        c.damping = m_options.lm.initialDamping;
+        active.append(k);
+    }
+
+    // 2. 逐轮: 并行续算 -> 移除已结束的候选 -> 淘汰落后者
+    MultiStartCandidate* data = candidates.data();
+    std::atomic<bool> stopped{false};
+    int stage = 0;
+    while (!active.isEmpty() && !stopped) {
+        const bool finalStage = active.size() <= survivors;
+        ComputeRuntime::instance()->parallelFor(active.size(), [&](int k) {
+            if (stopped.load(std::memory_order_relaxed)) return;
+            MultiStartCandidate& c = data[active[k]];
+            LevenbergMarquardtOptions options = m_options.lm;
+            options.initialDamping = c.damping;
+            options.maxIterations = budget - c.iterations;
+            if (!finalStage) options.maxIterations = std::min(options.maxIterations, m_options.stageIterations);
+
+            LevenbergMarquardtResult result = LevenbergMarquardtSolver(options).solve(problem, c.x);
+            if (result.aborted) {
+                stopped = true;
+                return;
+            }
+            c.x = result.x;
+            c.sse = result.sse;
+            c.mse = result.residuals.size() > 0 ? result.sse / result.residuals.size() : 0.0;
+            c.damping = result.damping;
+            c.iterations += result.iterations;
+            c.residualEvaluations += result.residualEvaluations;
+            c.jacobianEvaluations += result.jacobianEvaluations;
+            c.converged = result.converged;
+            c.stages++;
+        });
+        if (stopped) break;
+        ++stage;
+
+        QVector<int> running;
+        for (int id : active) {
+            if (!candidates[id].converged && candidates[id].iterations < budget) running.append(id);
+        }
+        int bestId = 0;
+        for (int k = 1; k < candidates.size(); ++k) {
+            if (candidates[k].sse < candidates[bestId].sse) bestId = k;
+        }
+
+        if (finalStage) {
+            active.clear();
+        } else {
+            // 保留均方误差最小的一半 (不少于 survivors)，且不落后当前最优 pruneRatio 倍
+            std::sort(running.begin(), running.end(),
+                      [&](int a, int b) { return candidates[a].sse < candidates[b].sse; });
+            int keep = std::max(survivors, static_cast<int>((running.size() + 1) / 2));
+            active.clear();
+            for (int k = 0; k < running.size(); ++k) {
+                MultiStartCandidate& c = candidates[running[k]];
+                if (k < keep && c.sse <= m_options.pruneRatio * candidates[bestId].sse) active.append(running[k]);
+                else c.pruned = true;
+            }
+        }
+
+        double progress = 1.0 - double(active.size()) / candidates.size();
+        if (onStage && !onStage(stage, progress, candidates[bestId])) stopped = true;
+    }
+    if (aborted) *aborted = stopped;
+
+    // 3. 按均方误差升序排序 (淘汰者的误差为截断时的值)
+    std::stable_sort(candidates.begin(), candidates.end(), [](const MultiStartCandidate& a, const MultiStartCandidate& b) {
+        return a.mse < b.mse;
+    });
+    return candidates;
+}
@@ -0,0 +1,66 @@
+/*
+ * 文件名: multistartfitter.h
+ * 文件作用: 多起点全局拟合 (拉丁超立方起点 + 截断 LM + 逐轮淘汰) 头文件
+ * 功能描述:
+ * 1. 在各变量的采样范围 (对数敏感参数为 log10 域) 内按拉丁超立方抽取 K 个起点，
+ *    连同界面参数表的当前值一起作为候选。
+ * 2. 每轮对仍在运行的候选并行执行若干步 LM (续算时沿用上一轮结束时的阻尼)，
+ *    之后按均方误差排序: 落后当前最优过多的候选淘汰，每轮最多保留一半。
+ * 3. 候选数不超过 survivors 后，幸存者在剩余的试探步预算内运行到收敛。
+ * 4. 返回按均方误差排序的全部候选 (含被淘汰者截断时的结果)，供界面列表选择。
+ */
+
+#ifndef MULTISTARTFITTER_H
+#define MULTISTARTFITTER_H
+
+#include <QVector>
+#include <functional>
+#include "levenbergmarquardt.h"
+
+struct MultiStartOptions {
+    int starts = 16;                 // 拉丁超立方起点数 (不含参数表当前值)
+    int survivors = 3;               // 运行到收敛的候选数
+    int stageIterations = 4;         // 每轮淘汰前的试探步数
+    double pruneRatio = 10.0;        // 均方误差超过当前最优的 pruneRatio 倍时淘汰
+    unsigned int seed = 20250519;    // 采样随机种子 (固定种子使结果可复现)
+    LevenbergMarquardtOptions lm;    // LM 设置 (maxIterations 为单个候选的试探步总预算)
+};
+
+struct MultiStartCandidate {
+    int startIndex = 0;             // 起点序号 (0 为参数表当前值)
+    Eigen::VectorXd start;          // 起点
+    Eigen::VectorXd x;              // 当前 (或最终) 解
+    double sse = 0.0;
+    double mse = 0.0;
+    double damping = 0.0;           // 续算使用的阻尼
+    int iterations = 0;             // 累计试探步数
+    int residualEvaluations = 0;
+    int jacobianEvaluations = 0;
+    int stages = 0;                 // 参与的轮数
+    bool converged = false;
+    bool pruned = false;            // 提前淘汰
+};
+
+class MultiStartFitter
+{
+public:
+    // 每轮结束后调用 (轮次, 已完成的比例 0~1, 当前最优候选)，返回 false 时中止
+    using StageCallback = std::function<bool(int stage, double progress, const MultiStartCandidate& best)>;
+
+    explicit MultiStartFitter(const MultiStartOptions& options = MultiStartOptions());
+
+    // 拉丁超立方采样: 每一维的 [lower, upper] 等分为 count 层，每层恰好一个样本
+    static QVector<Eigen::VectorXd> latinHypercube(const Eigen::VectorXd& lower, const Eigen::VectorXd& upper,
+                                                   int count, unsigned int seed);
+
+    // problem 的回调须可并发调用；sampleLower/sampleUpper 为起点采样范围 (应位于 problem 的盒约束之内)
+    // 返回按均方误差升序排列的候选；中止时 aborted 置为 true
+    QVector<MultiStartCandidate> run(const LeastSquaresProblem& problem, const Eigen::VectorXd& x0,
+                                     const Eigen::VectorXd& sampleLower, const Eigen::VectorXd& sampleUpper,
+                                     const StageCallback& onStage = StageCallback(), bool* aborted = nullptr) const;
+
+private:
+    MultiStartOptions m_options;
+};
+
+#endif // MULTISTARTFITTER_H
@@ -0,0 +1,99 @@
+/*
+ * 文件名: multistartresultdialog.cpp
+ * 文件作用: 全局拟合结果列表对话框实现
+ * 功能描述:
+ * 1. 表格列: 排名、均方误差、状态 (收敛 / 达到步数上限 / 提前淘汰)、起点、试探步数、各拟合参数。
+ * 2. 默认选中误差最小的一行，双击行等同于采用该解。
+ */
+
+#include "multistartresultdialog.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QColor>
+
+MultiStartResultDialog::MultiStartResultDialog(const QVector<MultiStartCandidate>& candidates, const QStringList& paramNames,
+                                               const QVector<QVector<double>>& values, const QString& summary, QWidget* parent)
+    : QDialog(parent), m_table(nullptr)
+{
+    setupUI(candidates, paramNames, values, summary);
+}
+
+void MultiStartResultDialog::setupUI(const QVector<MultiStartCandidate>& candidates, const QStringList& paramNames,
+                                     const QVector<QVector<double>>& values, const QString& summary)
+{
+    setWindowTitle("全局拟合结果");
+    resize(760, 420);
+    // 设置白色背景黑色字体，统一UI风格
+    setStyleSheet("QDialog { background-color: white; color: black; font-family: \"Microsoft YaHei\", Arial; } "
+                  "QLabel { color: black; background: transparent; } "
+                  "QTableWidget { gridline-color: #cccccc; color: #000000; background-color: #ffffff; alternate-background-color: #f9f9f9; } "
+                  "QPushButton { color: white; background-color: #4a90e2; border: none; border-radius: 4px; padding: 6px 12px; } "
+                  "QPushButton:hover { background-color: #357abd; }");
+
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->addWidget(new QLabel(summary));
+
+    // 结果表格
+    QStringList headers = {"排名", "误差(MSE)", "状态", "起点", "试探步"};
+    const int fixedColumns = headers.size();
+    headers += paramNames;
+
+    m_table = new QTableWidget(candidates.size(), headers.size());
+    m_table->setHorizontalHeaderLabels(headers);
+    m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_table->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setAlternatingRowColors(true);
+    m_table->verticalHeader()->setVisible(false);
+
+    for (int k = 0; k < candidates.size(); ++k) {
+        const MultiStartCandidate& c = candidates[k];
+        QString status = c.pruned ? "提前淘汰" : (c.converged ? "收敛" : "达到步数上限");
+        QString start = c.startIndex == 0 ? "参数表" : QString("LHS-%1").arg(c.startIndex);
+
+        m_table->setItem(k, 0, new QTableWidgetItem(QString::number(k + 1)));
+        m_table->setItem(k, 1, new QTableWidgetItem(QString::number(c.mse, 'e', 3)));
+        m_table->setItem(k, 2, new QTableWidgetItem(status));
+        m_table->setItem(k, 3, new QTableWidgetItem(start));
+        m_table->setItem(k, 4, new QTableWidgetItem(QString::number(c.iterations)));
+        for (int j = 0; j < paramNames.size() && k < values.size() && j < values[k].size(); ++j) {
+            m_table->setItem(k, fixedColumns + j, new QTableWidgetItem(QString::number(values[k][j], 'g', 5)));
+        }
+        // 被淘汰的候选以灰色显示
+        if (c.pruned) {
+            for (int col = 0; col < headers.size(); ++col) {
+                if (m_table->item(k, col)) m_table->item(k, col)->setForeground(QColor("#888888"));
+            }
+        }
+    }
+    m_table->resizeColumnsToContents();
+    if (!candidates.isEmpty()) m_table->selectRow(0);
+    mainLayout->addWidget(m_table);
+
+    connect(m_table, &QTableWidget::cellDoubleClicked, this, &QDialog::accept);
+
+    // 底部按钮
+    QHBoxLayout* btnLayout = new QHBoxLayout;
+    btnLayout->addStretch();
+    QPushButton* btnOk = new QPushButton("采用所选解");
+    QPushButton* btnCancel = new QPushButton("取消");
+    btnOk->setStyleSheet("background-color: #28a745; color: white;");
+    btnCancel->setStyleSheet("background-color: #6c757d; color: white;");
+
+    connect(btnOk, &QPushButton::clicked, this, &QDialog::accept);
+    connect(btnCancel, &QPushButton::clicked, this, &QDialog::reject);
+
+    btnLayout->addWidget(btnOk);
+    btnLayout->addWidget(btnCancel);
+    mainLayout->addLayout(btnLayout);
+}
+
+int MultiStartResultDialog::selectedCandidate() const
+{
+    QList<QTableWidgetItem*> items = m_table->selectedItems();
+    return items.isEmpty() ? -1 : items.first()->row();
+}
@@ -0,0 +1,37 @@
+/*
+ * 文件名: multistartresultdialog.h
+ * 文件作用: 全局拟合结果列表对话框头文件
+ * 功能描述:
+ * 1. 按均方误差排序列出多起点全局拟合的全部候选解 (误差、状态、试探步数及各拟合参数值)。
+ * 2. 用户选中一行后点击“采用所选解”，由调用方将该解写回参数表。
+ */
+
+#ifndef MULTISTARTRESULTDIALOG_H
+#define MULTISTARTRESULTDIALOG_H
+
+#include <QDialog>
+#include <QStringList>
+#include <QVector>
+#include "multistartfitter.h"
+
+class QTableWidget;
+
+class MultiStartResultDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    // candidates 已按均方误差排序；values[k][j] 为第 k 个候选第 j 个拟合参数的取值
+    MultiStartResultDialog(const QVector<MultiStartCandidate>& candidates, const QStringList& paramNames,
+                           const QVector<QVector<double>>& values, const QString& summary, QWidget* parent = nullptr);
+
+    // 选中的候选序号 (未选中时返回 -1)
+    int selectedCandidate() const;
+
+private:
+    void setupUI(const QVector<MultiStartCandidate>& candidates, const QStringList& paramNames,
+                 const QVector<QVector<double>>& values, const QString& summary);
+
+    QTableWidget* m_table;
+};
+
+#endif // MULTISTARTRESULTDIALOG_H
@@ -214,7 +214,8 @@ PressureDerivativeResult PressureDerivativeCalculator::calculatePressureDerivati
 QVector<double> PressureDerivativeCalculator::calculateBourdetDerivative(
     const QVector<double>& timeData,
     const QVector<double>& pressureDropData,
-    double lSpacing)
+    double lSpacing,
+    bool absolute)
 {
     QVector<double> derivativeData;
     int n = timeData.size();
@@ -284,7 +285,7 @@ QVector<double> PressureDerivativeCalculator::calculateBourdetDerivative(
         }
 
         // 导数结果取绝对值（双对数图要求正值）
-        derivativeData.append(std::abs(derivative));
+        derivativeData.append(absolute ? std::abs(derivative) : derivative);
     }
 
     return derivativeData;
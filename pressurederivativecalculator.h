@@ -113,11 +113,12 @@ public:
      * @param timeData 时间数据 (t)
      * @param pressureDropData 压降数据 (Delta P)
      * @param lSpacing L-Spacing参数
+     * @param absolute 是否取绝对值 (双对数图要求正值)；为 false 时结果对压降数据是线性的
      * @return 导数数据向量
      */
     static QVector<double> calculateBourdetDerivative(const QVector<double>& timeData,
                                                       const QVector<double>& pressureDropData,
-                                                      double lSpacing);
+                                                      double lSpacing, bool absolute = true);
 
 signals:
     void progressUpdated(int progress, const QString& message);
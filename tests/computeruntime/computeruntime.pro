@@ -0,0 +1,38 @@
+######################################################################
+# 计算运行时测试: 嵌套 parallelFor 与拟合运行期间的预览曲线延迟
+######################################################################
+QT += core gui testlib
+QT -= widgets
+
+TEMPLATE = app
+TARGET = tst_computeruntime
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../..
+INCLUDEPATH += D:/08YYYXXX/eigen-3.3.8
+
+HEADERS += ../../besselintegral.h \
+           ../../besselkernels.h \
+           ../../computeruntime.h \
+           ../../dimensionlesscurvecache.h \
+           ../../laplaceinversion.h \
+           ../../levenbergmarquardt.h \
+           ../../modelparamvector.h \
+           ../../modelsolver01-06.h \
+           ../../monotonecubic.h \
+           ../../multistartfitter.h \
+           ../../pressurederivativecalculator.h
+
+SOURCES += tst_computeruntime.cpp \
+           ../../besselintegral.cpp \
+           ../../besselkernels.cpp \
+           ../../computeruntime.cpp \
+           ../../dimensionlesscurvecache.cpp \
+           ../../laplaceinversion.cpp \
+           ../../levenbergmarquardt.cpp \
+           ../../modelparamvector.cpp \
+           ../../modelsolver01-06.cpp \
+           ../../monotonecubic.cpp \
+           ../../multistartfitter.cpp \
+           ../../pressurederivativecalculator.cpp
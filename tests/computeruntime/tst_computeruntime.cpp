@@ -0,0 +1,178 @@
+/*
+ * 文件名: tst_computeruntime.cpp
+ * 文件作用: 计算运行时测试
+ * 功能描述:
+ * 1. 嵌套 parallelFor: 每个下标恰好执行一次，结果与串行相同。
+ * 2. 异常: body 抛出的异常在本层结束后于调用线程重新抛出，运行时仍可继续使用。
+ * 3. 预览延迟: 多起点拟合运行期间，外部线程 (预览) 计算理论曲线时不执行拟合的区间 (候选解、雅可比列)，
+ *    耗时只随 CPU 分时放慢，即等待中的线程不会窃取其他 parallelFor 的区间。
+ */
+
+#include <QtTest>
+#include <QElapsedTimer>
+#include <QThread>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include "computeruntime.h"
+#include "modelsolver01-06.h"
+#include "multistartfitter.h"
+
+namespace {
+
+QMap<QString, double> modelParams()
+{
+    QMap<QString, double> p;
+    p["phi"] = 0.05; p["h"] = 20; p["mu"] = 0.5; p["B"] = 1.05; p["Ct"] = 5e-4; p["q"] = 5;
+    p["nf"] = 4; p["kf"] = 1e-3; p["km"] = 1e-4; p["L"] = 1000; p["Lf"] = 100; p["LfD"] = 0.1;
+    p["rmD"] = 4; p["omega1"] = 0.4; p["omega2"] = 0.08; p["lambda1"] = 1e-3; p["gamaD"] = 0.02;
+    p["N"] = 8; p["cD"] = 0.01; p["S"] = 1;
+    return p;
+}
+
+} // namespace
+
+class TestComputeRuntime : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void nestedParallelFor();
+    void exceptionPropagates();
+    void previewLatencyDuringMultistart();
+};
+
+void TestComputeRuntime::initTestCase()
+{
+    // 单核机器上也用多个工作线程，保证拟合候选解排在队列中等待领取
+    ComputeRuntime::instance()->setWorkerCount(std::max(4, QThread::idealThreadCount()));
+}
+
+void TestComputeRuntime::nestedParallelFor()
+{
+    const int outer = 64, inner = 257;
+    std::vector<std::atomic<int>> hits(outer * inner);
+    for (auto& h : hits) h = 0;
+    ComputeRuntime::instance()->parallelFor(outer, [&](int i) {
+        ComputeRuntime::instance()->parallelFor(inner, [&](int j) { hits[i * inner + j]++; }, 4);
+    });
+    for (const auto& h : hits) QCOMPARE(h.load(), 1);
+}
+
+void TestComputeRuntime::exceptionPropagates()
+{
+    ComputeRuntime* runtime = ComputeRuntime::instance();
+    std::atomic<int> executed{0};
+    bool caught = false;
+    try {
+        runtime->parallelFor(64, [&](int i) {
+            runtime->parallelFor(32, [&](int j) {
+                executed++;
+                if (i == 37 && j == 5) throw std::runtime_error("body failed");
+            });
+        });
+    } catch (const std::runtime_error& e) {
+        caught = QString(e.what()) == QString("body failed");
+    }
+    QVERIFY(caught);
+    QVERIFY(executed.load() <= 64 * 32);
+
+    // 抛出异常后各层计数已归零，运行时可以继续使用
+    std::atomic<int> sum{0};
+    runtime->parallelFor(1000, [&](int i) { sum += i; });
+    QCOMPARE(sum.load(), 999 * 1000 / 2);
+}
+
+void TestComputeRuntime::previewLatencyDuringMultistart()
+{
+    ComputeRuntime* runtime = ComputeRuntime::instance();
+    const ModelSolver01_06 solver(ModelSolver01_06::Model_1);
+    const QMap<QString, double> truth = modelParams();
+    const QVector<double> t = ModelSolver01_06::generateLogTimeSteps(300, -2, 3);
+    const ModelCurveData reference = solver.calculateTheoreticalCurve(truth, t);
+
+    // 界面空闲时的预览耗时
+    QElapsedTimer timer;
+    timer.start();
+    solver.calculateTheoreticalCurve(truth, t);
+    const qint64 idleMs = timer.elapsed();
+
+    // 拟合 kf、km (log10 域)；拟合数据的点数远多于预览，每个候选解的一轮 (若干次残差计算) 远长于一次预览
+    const QVector<double> tFit = ModelSolver01_06::generateLogTimeSteps(2000, -2, 3);
+    const ModelCurveData data = solver.calculateTheoreticalCurve(truth, tFit, ModelSolverOptions(false));
+    // 在预览线程上执行的残差计算次数 (预览线程窃取了拟合的区间)
+    const std::thread::id previewThread = std::this_thread::get_id();
+    std::atomic<bool> previewing{false};
+    std::atomic<int> stolenEvaluations{0};
+    LeastSquaresProblem problem;
+    problem.lower = Eigen::Vector2d(-5.0, -6.0);
+    problem.upper = Eigen::Vector2d(0.0, 0.0);
+    problem.residuals = [&](const Eigen::VectorXd& x, Eigen::VectorXd& r) {
+        if (previewing && std::this_thread::get_id() == previewThread) stolenEvaluations++;
+        QMap<QString, double> p = truth;
+        p["kf"] = std::pow(10.0, x(0));
+        p["km"] = std::pow(10.0, x(1));
+        const ModelCurveData curve = solver.calculateTheoreticalCurve(p, tFit, ModelSolverOptions(false));
+        r.resize(tFit.size());
+        for (int i = 0; i < tFit.size(); ++i) {
+            r(i) = std::log(std::max(std::get<1>(curve)[i], 1e-10)) - std::log(std::get<1>(data)[i]);
+        }
+        return true;
+    };
+    Eigen::VectorXd r0;
+    timer.start();
+    problem.residuals(Eigen::Vector2d(-2.5, -3.5), r0);
+    const qint64 evaluationMs = timer.elapsed();
+    problem.jacobian = [&](const Eigen::VectorXd& x, const Eigen::VectorXd& r, Eigen::MatrixXd& J) {
+        J.resize(r.size(), x.size());
+        std::atomic<bool> ok{true};
+        runtime->parallelFor(x.size(), [&](int j) {
+            Eigen::VectorXd xh = x, rh;
+            xh(j) += 1e-4;
+            if (!problem.residuals(xh, rh)) ok = false;
+            J.col(j) = (rh - r) / 1e-4;
+        });
+        return ok.load();
+    };
+
+    MultiStartOptions options;
+    options.starts = 4 * runtime->workerCount();
+    options.survivors = 2;
+    options.lm.maxIterations = 40;
+    std::atomic<bool> fitting{true};
+    runtime->submit([&]() {
+        MultiStartFitter(options).run(problem, Eigen::Vector2d(-2.5, -3.5), problem.lower, problem.upper);
+        fitting = false;
+    });
+    QThread::msleep(std::max<qint64>(100, 3 * evaluationMs));
+
+    // 拟合运行期间 (含候选数少于工作线程数、有线程空闲的后几轮) 在外部线程 (相当于预览线程) 反复计算理论曲线
+    qint64 worstMs = 0;
+    int previews = 0;
+    bool sameCurve = true;
+    previewing = true;
+    while (fitting) {
+        ComputeRuntime::InteractiveScope interactive;   // 与 FitScheduler::runInteractive 相同
+        timer.start();
+        const ModelCurveData curve = solver.calculateTheoreticalCurve(truth, t);
+        worstMs = std::max(worstMs, timer.elapsed());
+        sameCurve = sameCurve && std::get<1>(curve) == std::get<1>(reference);
+        ++previews;
+    }
+    previewing = false;
+    QVERIFY(previews > 0);
+    QVERIFY(sameCurve);
+    // 预览线程只执行自己的区间，不执行拟合的候选解或雅可比列
+    QCOMPARE(stolenEvaluations.load(), 0);
+    // 延迟: 预览与各工作线程分时共享 CPU (核数少于线程数时按比例放慢)，不应再多出拟合的计算
+    const int cores = std::max(1, QThread::idealThreadCount());
+    const int sharing = (runtime->workerCount() + cores) / cores;
+    QVERIFY2(worstMs < 2 * sharing * idleMs + 2 * evaluationMs,
+             qPrintable(QString("worst preview %1 ms, idle %2 ms").arg(worstMs).arg(idleMs)));
+}
+
+QTEST_GUILESS_MAIN(TestComputeRuntime)
+
+#include "tst_computeruntime.moc"
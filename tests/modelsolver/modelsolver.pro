@@ -0,0 +1,34 @@
+######################################################################
+# 模型求解器测试: Laplace 解代理网格与逐节点计算的一致性
+######################################################################
+QT += core gui testlib
+QT -= widgets
+
+TEMPLATE = app
+TARGET = tst_modelsolver
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../..
+INCLUDEPATH += D:/08YYYXXX/eigen-3.3.8
+
+HEADERS += ../../besselintegral.h \
+           ../../besselkernels.h \
+           ../../computeruntime.h \
+           ../../dimensionlesscurvecache.h \
+           ../../laplaceinversion.h \
+           ../../modelparamvector.h \
+           ../../modelsolver01-06.h \
+           ../../monotonecubic.h \
+           ../../pressurederivativecalculator.h
+
+SOURCES += tst_modelsolver.cpp \
+           ../../besselintegral.cpp \
+           ../../besselkernels.cpp \
+           ../../computeruntime.cpp \
+           ../../dimensionlesscurvecache.cpp \
+           ../../laplaceinversion.cpp \
+           ../../modelparamvector.cpp \
+           ../../modelsolver01-06.cpp \
+           ../../monotonecubic.cpp \
+           ../../pressurederivativecalculator.cpp
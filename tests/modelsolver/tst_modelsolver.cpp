@@ -0,0 +1,155 @@
+/*
+ * 文件名: tst_modelsolver.cpp
+ * 文件作用: 模型求解器测试
+ * 功能描述:
+ * 1. Laplace 解代理网格 (拟合迭代使用) 与逐节点计算 (默认) 的理论曲线一致: 六个模型、N = 8 / 12 / 16，
+ *    压力与导数的相对误差在容差内 (远小于同一 N 下 Stehfest 反演本身的误差)，且代理网格确实减少了 Laplace 解的计算次数。
+ * 2. 拟合迭代设置 (插值粗网格 + 代理网格) 下，calculateCurveSensitivities 给出的偏导数与理论曲线的中心差分一致，
+ *    即雅可比矩阵是残差函数的导数 (两者使用同一条无因次曲线的网格与插值)。
+ */
+
+#include <QtTest>
+#include <cmath>
+#include "modelsolver01-06.h"
+
+namespace {
+
+QMap<QString, double> modelParams(int model, int nodes)
+{
+    QMap<QString, double> p;
+    p["phi"] = 0.05; p["h"] = 20; p["mu"] = 0.5; p["B"] = 1.05; p["Ct"] = 5e-4; p["q"] = 5;
+    p["nf"] = 4; p["kf"] = 1e-3; p["km"] = 1e-4; p["L"] = 1000; p["Lf"] = 100; p["LfD"] = 0.1;
+    p["rmD"] = 4; p["omega1"] = 0.4; p["omega2"] = 0.08; p["lambda1"] = 1e-3; p["gamaD"] = 0.02;
+    p["N"] = nodes;
+    const bool variableStorage = (model % 2 == 0);
+    p["cD"] = variableStorage ? 0.01 : 0.0;
+    p["S"] = variableStorage ? 1.0 : 0.0;
+    if (model >= ModelSolver01_06::Model_3) p["reD"] = 10;
+    return p;
+}
+
+double maxRelativeError(const QVector<double>& value, const QVector<double>& reference)
+{
+    double error = 0.0;
+    for (int i = 0; i < reference.size(); ++i) {
+        error = std::max(error, std::abs(value[i] / reference[i] - 1.0));
+    }
+    return error;
+}
+
+// 拟合迭代的求解设置 (与 FitJob::iterationOptions 相同，不含停止标志)
+ModelSolverOptions iterationOptions()
+{
+    ModelSolverOptions options(false);
+    options.inversionNodes = 8;
+    options.laplaceGridPointsPerDecade = 32;
+    options.interpolate = true;
+    return options;
+}
+
+} // namespace
+
+class TestModelSolver : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void surrogateMatchesExact_data();
+    void surrogateMatchesExact();
+    void sensitivitiesMatchCurve_data();
+    void sensitivitiesMatchCurve();
+};
+
+void TestModelSolver::surrogateMatchesExact_data()
+{
+    QTest::addColumn<int>("model");
+    QTest::addColumn<int>("nodes");
+    QTest::addColumn<double>("pressureTolerance");
+    QTest::addColumn<double>("derivativeTolerance");
+
+    // 容差约为实测误差的 10 倍 (N = 16 时压力约 7e-7，同一 N 下反演误差约 3e-5)
+    for (int model = ModelSolver01_06::Model_1; model <= ModelSolver01_06::Model_6; ++model) {
+        QTest::addRow("model%d-N8", model + 1) << model << 8 << 1e-8 << 1e-6;
+        QTest::addRow("model%d-N12", model + 1) << model << 12 << 1e-7 << 2e-5;
+        QTest::addRow("model%d-N16", model + 1) << model << 16 << 1e-5 << 1e-3;
+    }
+}
+
+void TestModelSolver::surrogateMatchesExact()
+{
+    QFETCH(int, model);
+    QFETCH(int, nodes);
+    QFETCH(double, pressureTolerance);
+    QFETCH(double, derivativeTolerance);
+
+    const ModelSolver01_06 solver(static_cast<ModelSolver01_06::ModelType>(model));
+    const QMap<QString, double> params = modelParams(model, nodes);
+    const QVector<double> t = ModelSolver01_06::generateLogTimeSteps(200, -3, 3);
+
+    ModelSolverOptions exactOptions;
+    const ModelCurveData exact = solver.calculateTheoreticalCurve(params, t, exactOptions);
+
+    ModelSolverStats stats;
+    ModelSolverOptions surrogateOptions;
+    surrogateOptions.laplaceGridPointsPerDecade = 32;
+    surrogateOptions.stats = &stats;
+    const ModelCurveData surrogate = solver.calculateTheoreticalCurve(params, t, surrogateOptions);
+
+    QVERIFY(stats.laplaceEvaluationsSaved.load() > 0);
+    QVERIFY(stats.laplaceEvaluations.load() * 4 < static_cast<long long>(t.size()) * nodes);
+    QVERIFY(maxRelativeError(std::get<1>(surrogate), std::get<1>(exact)) < pressureTolerance);
+    QVERIFY(maxRelativeError(std::get<2>(surrogate), std::get<2>(exact)) < derivativeTolerance);
+}
+
+void TestModelSolver::sensitivitiesMatchCurve_data()
+{
+    QTest::addColumn<int>("model");
+    for (int model = ModelSolver01_06::Model_1; model <= ModelSolver01_06::Model_6; ++model) {
+        QTest::addRow("model%d", model + 1) << model;
+    }
+}
+
+void TestModelSolver::sensitivitiesMatchCurve()
+{
+    QFETCH(int, model);
+
+    const ModelSolver01_06 solver(static_cast<ModelSolver01_06::ModelType>(model));
+    const ModelParamVector params = ModelParamVector::fromMap(modelParams(model, 8));
+    const QVector<double> t = ModelSolver01_06::generateLogTimeSteps(400, -2, 3);
+    const ModelSolverOptions options = iterationOptions();
+    // 形状参数 (kf 同时改变时间比例)、联动参数 Lf (LfD = Lf / L) 与只占时间比例方向的 phi
+    const QVector<int> ids = {Param_kf, Param_km, Param_Lf, Param_omega1, Param_lambda1, Param_phi};
+
+    // 与拟合相同的顺序: 先算残差 (放入缓存)，再算雅可比
+    const ModelCurveData curve = solver.calculateTheoreticalCurve(params, t, options);
+    const ModelCurveSensitivity sens = solver.calculateCurveSensitivities(params, ids, t, options);
+    QCOMPARE(sens.dPressure.size(), ids.size());
+
+    // 对数参数的中心差分: ∂ln p / ∂ln θ (步长使反演舍入误差与截断误差均约 1e-8；步长过大时网格细化可能改变)
+    const double h = 1e-4;
+    for (int j = 0; j < ids.size(); ++j) {
+        ModelParamVector plus = params, minus = params;
+        plus[ids[j]] *= std::exp(h);
+        minus[ids[j]] *= std::exp(-h);
+        plus.updateDependent();
+        minus.updateDependent();
+        const ModelCurveData cp = solver.calculateTheoreticalCurve(plus, t, options);
+        const ModelCurveData cm = solver.calculateTheoreticalCurve(minus, t, options);
+        double pressureError = 0.0, derivativeError = 0.0;
+        for (int i = 0; i < t.size(); ++i) {
+            double fd = (std::log(std::get<1>(cp)[i]) - std::log(std::get<1>(cm)[i])) / (2.0 * h);
+            double ad = sens.dPressure[j][i] / std::get<1>(curve)[i] * params[ids[j]];
+            pressureError = std::max(pressureError, std::abs(fd - ad));
+            fd = (std::log(std::get<2>(cp)[i]) - std::log(std::get<2>(cm)[i])) / (2.0 * h);
+            ad = sens.dDerivative[j][i] / std::get<2>(curve)[i] * params[ids[j]];
+            derivativeError = std::max(derivativeError, std::abs(fd - ad));
+        }
+        // 实测压力约 3e-8、导数约 3e-6 (修正前雅可比取自另一网格与插值，误差达 1e-2 量级)
+        QVERIFY2(pressureError < 1e-6, qPrintable(QString("%1: pressure %2").arg(ModelParamVector::nameOf(ids[j])).arg(pressureError)));
+        QVERIFY2(derivativeError < 1e-4, qPrintable(QString("%1: derivative %2").arg(ModelParamVector::nameOf(ids[j])).arg(derivativeError)));
+    }
+}
+
+QTEST_GUILESS_MAIN(TestModelSolver)
+
+#include "tst_modelsolver.moc"
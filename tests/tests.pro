@@ -0,0 +1,7 @@
+######################################################################
+# 计算层单元测试 (Qt Test)，在 tests 目录下执行 qmake && make check
+######################################################################
+TEMPLATE = subdirs
+
+SUBDIRS += computeruntime \
+           modelsolver
@@ -4,7 +4,9 @@
  * 功能描述:
  * 1. 初始化拟合分析界面，配置图表控件 (QCustomPlot) 和参数表格。
  * 2. 实现观测数据的加载逻辑，支持根据试井类型（降落/恢复）计算压差 (Delta P)。
- * 3. 核心算法实现：完整实现了 Levenberg-Marquardt (LM) 非线性最小二乘拟合算法。
+ * 3. 拟合：以观测数据、参数表和拟合设置的快照创建拟合任务 (fitjob.h)，任务在后台线程运行
+ *    信赖域 LM、多起点全局拟合或差分进化，界面经 QFuture 接收进度与结果，定时读取迭代参数刷新预览；
+ *    全局拟合结束后在结果列表中选择解。
  * 4. 提供丰富的交互功能：手动调整参数、权重滑块、模型选择、图表视图控制。
  * 5. 提供结果输出功能：导出拟合参数、导出图表图片、生成 HTML 分析报告。
  */
@@ -16,8 +18,11 @@
 #include "fittingdatadialog.h"
 #include "pressurederivativecalculator.h"
 #include "pressurederivativecalculator1.h"
+#include "multistartresultdialog.h"
+#include "fitscheduler.h"
 
 #include <QtConcurrent>
+#include <QThread>
 #include <QMessageBox>
 #include <QDebug>
 #include <cmath>
@@ -52,7 +57,9 @@ FittingWidget::FittingWidget(QWidget *parent) :
     m_projectModel(nullptr),
     m_plotTitle(nullptr),
     m_currentModelType(ModelManager::Model_1),
-    m_isFitting(false)
+    m_isFitting(false),
+    m_previewRunning(false),
+    m_previewPending(false)
 {
     // 加载 UI 布局
     ui->setupUi(this);
@@ -81,8 +88,17 @@ FittingWidget::FittingWidget(QWidget *parent) :
     connect(this, &FittingWidget::sigIterationUpdated, this, &FittingWidget::onIterationUpdate, Qt::QueuedConnection);
     // 2. 进度信号 -> 更新进度条
     connect(this, &FittingWidget::sigProgress, ui->progressBar, &QProgressBar::setValue);
-    // 3. 异步任务监视器完成信号 -> 处理拟合结束
-    connect(&m_watcher, &QFutureWatcher<void>::finished, this, &FittingWidget::onFitFinished);
+    // 3. 拟合任务监视器: 进度值 -> 进度信号，完成 -> 处理拟合结束
+    //    任务状态: 排队 -> 开始运行 -> 进度百分比 -> 结束 (页签状态显示)
+    connect(&m_watcher, &QFutureWatcher<FitJobResult>::progressValueChanged, this, &FittingWidget::sigProgress);
+    connect(&m_watcher, &QFutureWatcher<FitJobResult>::finished, this, &FittingWidget::onFitFinished);
+    connect(&m_watcher, &QFutureWatcher<FitJobResult>::started, this, [this](){ setFitStatus("拟合中"); });
+    connect(&m_watcher, &QFutureWatcher<FitJobResult>::progressValueChanged, this, [this](int value){
+        setFitStatus(QString("拟合中 %1%").arg(value));
+    });
+
+    // 拟合结束摘要 (非模态，多个页签的拟合无人值守结束时不弹出对话框)
+    ui->label_FitSummary->hide();
 
     // 连接权重滑块变化信号 -> 更新权重数值标签
     connect(ui->sliderWeight, &QSlider::valueChanged, this, &FittingWidget::onSliderWeightChanged);
@@ -91,6 +107,45 @@ FittingWidget::FittingWidget(QWidget *parent) :
     ui->sliderWeight->setRange(0, 100);
     ui->sliderWeight->setValue(50);
     onSliderWeightChanged(50);
+
+    // 拟合抽稀: 每个对数周期的点数 (0 表示使用全部观测点)
+    ui->spinPointsPerDecade->setRange(0, 200);
+    ui->spinPointsPerDecade->setSpecialValueText("不抽稀");
+    ui->spinPointsPerDecade->setValue(20);
+
+    // 拟合迭代的雅可比矩阵: 默认每次迭代完整计算，勾选后在迭代间使用 Broyden 秩一更新
+    ui->chkBroydenUpdate->setChecked(false);
+
+    // 变量投影: 默认关闭；时间平移只在勾选平移消元时可选
+    ui->chkVariableProjection->setChecked(false);
+    ui->chkProjectTimeShift->setChecked(false);
+    ui->chkProjectTimeShift->setEnabled(false);
+    connect(ui->chkVariableProjection, &QCheckBox::toggled, ui->chkProjectTimeShift, &QCheckBox::setEnabled);
+
+    // 全局拟合: 拉丁超立方起点数 (另加参数表当前值作为一个起点)
+    ui->spinGlobalStarts->setRange(2, 64);
+    ui->spinGlobalStarts->setValue(16);
+
+    // 单次拟合的优化算法 (选项顺序与 FitOptimizer 一致)；LM 精修仅对差分进化有效
+    ui->comboOptimizer->addItem("Levenberg-Marquardt");
+    ui->comboOptimizer->addItem("差分进化 (DE)");
+    ui->comboOptimizer->setCurrentIndex(Optimizer_LevenbergMarquardt);
+    ui->chkPolishLM->setChecked(true);
+    ui->chkPolishLM->setEnabled(false);
+    connect(ui->comboOptimizer, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index){
+        ui->chkPolishLM->setEnabled(index == Optimizer_DifferentialEvolution);
+    });
+
+    // 拟合迭代的反演精度 (理论曲线相对误差上限)，默认与原先的 4 节点低精度反演相同
+    ui->comboInversionAccuracy->addItem("快速 (10%)", 1e-1);
+    ui->comboInversionAccuracy->addItem("标准 (1%)", 1e-2);
+    ui->comboInversionAccuracy->addItem("精确 (0.1%)", 1e-3);
+    ui->comboInversionAccuracy->addItem("高精 (0.01%)", 1e-4);
+    ui->comboInversionAccuracy->setCurrentIndex(0);
+
+    // 拟合进度: 约 30 帧/秒读取最新进度；预览曲线以交互优先级提交到 Qt 全局线程池，不排在拟合任务之后
+    m_progressTimer.setInterval(33);
+    connect(&m_progressTimer, &QTimer::timeout, this, &FittingWidget::onProgressTimer);
 }
 
 /**
@@ -98,6 +153,15 @@ FittingWidget::FittingWidget(QWidget *parent) :
  */
 FittingWidget::~FittingWidget()
 {
+    // 取消拟合任务: 排队中的任务直接撤销，运行中的任务在模型节点循环中检查停止标志，很快结束
+    if(m_fitJob) {
+        m_watcher.disconnect(this);
+        FitScheduler::instance()->cancel(m_fitJob);
+        m_watcher.waitForFinished();
+    }
+    // 放弃预览结果并等待正在计算的预览任务结束
+    m_previewActive = false;
+    m_previewFuture.waitForFinished();
     delete ui;
 }
 
@@ -422,33 +486,76 @@ void FittingWidget::on_btnSelectParams_clicked()
  * @brief 开始拟合按钮点击
  */
 void FittingWidget::on_btnRunFit_clicked() {
+    startFitting(false);
+}
+
+/**
+ * @brief 全局拟合按钮点击
+ */
+void FittingWidget::on_btnGlobalFit_clicked() {
+    startFitting(true);
+}
+
+/**
+ * @brief 校验数据、读取拟合设置并启动拟合任务
+ * 拟合任务复制抽稀数据、全分辨率数据与参数表，运行期间界面可以修改观测数据和参数而不影响拟合。
+ * @param global 为真时运行多起点全局拟合，否则按所选优化算法从参数表当前值拟合
+ */
+void FittingWidget::startFitting(bool global) {
     if(m_isFitting) return; // 防止重复点击
     if(m_obsTime.isEmpty()) {
         QMessageBox::warning(this,"错误","请先加载观测数据。");
         return;
     }
+    if(!m_modelManager) {
+        QMessageBox::critical(this, "错误", "ModelManager 未初始化！");
+        return;
+    }
 
     // 同步参数并禁用按钮
     m_paramChart->updateParamsFromTable();
     m_isFitting = true;
-    m_stopRequested = false;
     ui->btnRunFit->setEnabled(false);
-
-    ModelManager::ModelType modelType = m_currentModelType;
-    QList<FitParameter> paramsCopy = m_paramChart->getParameters();
-    double w = ui->sliderWeight->value() / 100.0;
-
-    // 使用 QtConcurrent 在后台线程运行拟合优化任务，避免阻塞 UI 主线程
-    (void)QtConcurrent::run([this, modelType, paramsCopy, w](){
-        runOptimizationTask(modelType, paramsCopy, w);
-    });
+    ui->btnGlobalFit->setEnabled(false);
+    showFitSummary(QString());
+
+    FitJobSettings settings;
+    settings.modelType = m_currentModelType;
+    settings.params = m_paramChart->getParameters();
+    settings.weight = ui->sliderWeight->value() / 100.0;
+    settings.global = global;
+    settings.globalStarts = ui->spinGlobalStarts->value();
+    settings.optimizer = static_cast<FitOptimizer>(ui->comboOptimizer->currentIndex());
+    settings.polishWithLM = ui->chkPolishLM->isChecked();
+    settings.broydenUpdate = ui->chkBroydenUpdate->isChecked();
+    settings.variableProjection = ui->chkVariableProjection->isChecked();
+    settings.projectTimeShift = ui->chkProjectTimeShift->isChecked();
+    settings.inversionTolerance = ui->comboInversionAccuracy->currentData().toDouble();
+
+    // 按对数时间窗口抽稀观测数据，迭代中只在窗口代表点上计算残差；抽稀时另存全分辨率数据计算最终误差
+    settings.fitData = LogTimeResampler::resample(m_obsTime, m_obsDeltaP, m_obsDerivative, ui->spinPointsPerDecade->value());
+    if(settings.fitData.size() != m_obsTime.size())
+        settings.fullData = LogTimeResampler::resample(m_obsTime, m_obsDeltaP, m_obsDerivative, 0);
+
+    // 开始定时读取进度 (新一代预览: 上一次拟合尚未完成的预览结果不再绘制)
+    ++m_previewGeneration;
+    m_previewPending = false;
+    m_previewActive = true;
+    m_progressTimer.start();
+
+    // 提交到全局调度器: 运行任务数已满时排队 (局部拟合排在全局拟合之前)，开始运行后由监视器的 started 信号更新状态
+    const bool globalSearch = settings.global || settings.optimizer == Optimizer_DifferentialEvolution;
+    m_fitJob = std::make_shared<FitJob>(m_modelManager, settings);
+    setFitStatus("排队中");
+    m_watcher.setFuture(FitScheduler::instance()->submit(
+        m_fitJob, globalSearch ? FitScheduler::Priority_Global : FitScheduler::Priority_Local));
 }
 
 /**
- * @brief 停止拟合按钮点击
+ * @brief 停止拟合按钮点击: 拟合在当前步结束，保留已得到的最优解；排队中的任务直接撤销
  */
 void FittingWidget::on_btnStop_clicked() {
-    m_stopRequested = true;
+    if(m_fitJob) FitScheduler::instance()->stop(m_fitJob);
 }
 
 /**
@@ -584,308 +691,6 @@ void FittingWidget::on_btnExportChart_clicked() {
     else QMessageBox::critical(this, "错误", "导出图表失败。");
 }
 
-// ===========================================================================
-// 拟合算法核心实现 (Levenberg-Marquardt)
-// ===========================================================================
-
-/**
- * @brief 运行优化任务的入口函数
- */
-void FittingWidget::runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight) {
-    runLevenbergMarquardtOptimization(modelType, fitParams, weight);
-}
-
-/**
- * @brief Levenberg-Marquardt 算法具体实现
- * @param modelType 模型类型
- * @param params 参数列表
- * @param weight 权重 (0~1)
- */
-void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight) {
-    // 设置模型计算为低精度模式以提高迭代速度
-    if(m_modelManager) m_modelManager->setHighPrecision(false);
-
-    // 1. 确定需要拟合的参数索引
-    QVector<int> fitIndices;
-    for(int i=0; i<params.size(); ++i) {
-        if(params[i].isFit) fitIndices.append(i);
-    }
-    int nParams = fitIndices.size();
-
-    // 如果没有勾选任何拟合参数，直接结束
-    if(nParams == 0) {
-        QMetaObject::invokeMethod(this, "onFitFinished");
-        return;
-    }
-
-    // 2. 初始化算法参数
-    double lambda = 0.01;      // 阻尼因子 (initial damping factor)
-    int maxIter = 50;          // 最大迭代次数
-    double currentSSE = 1e15;  // 当前误差平方和 (Sum Squared Error)
-
-    // 构建参数映射表
-    QMap<QString, double> currentParamMap;
-    for(const auto& p : params) currentParamMap.insert(p.name, p.value);
-
-    // 初始参数联动处理 (LfD = Lf / L)
-    if(currentParamMap.contains("L") && currentParamMap.contains("Lf") && currentParamMap["L"] > 1e-9)
-        currentParamMap["LfD"] = currentParamMap["Lf"] / currentParamMap["L"];
-
-    // 3. 计算初始状态的残差和误差
-    QVector<double> residuals = calculateResiduals(currentParamMap, modelType, weight);
-    currentSSE = calculateSumSquaredError(residuals);
-
-    // 通知界面更新初始状态
-    ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-    emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
-
-    // 4. 迭代主循环
-    for(int iter = 0; iter < maxIter; ++iter) {
-        if(m_stopRequested) break; // 响应用户停止请求
-
-        // 收敛判据：如果均方误差足够小，提前结束
-        if (!residuals.isEmpty() && (currentSSE / residuals.size()) < 3e-3) break;
-
-        emit sigProgress(iter * 100 / maxIter);
-
-        // 计算雅可比矩阵 J (size: nResiduals x nParams)
-        QVector<QVector<double>> J = computeJacobian(currentParamMap, residuals, fitIndices, modelType, params, weight);
-        int nRes = residuals.size();
-
-        // 构造正规方程的近似 Hessian 矩阵 H = J^T * J 和 梯度向量 g = J^T * r
-        QVector<QVector<double>> H(nParams, QVector<double>(nParams, 0.0));
-        QVector<double> g(nParams, 0.0);
-
-        for(int k=0; k<nRes; ++k) {
-            for(int i=0; i<nParams; ++i) {
-                // 计算梯度 g
-                g[i] += J[k][i] * residuals[k];
-                // 计算 Hessian 的下三角部分
-                for(int j=0; j<=i; ++j) {
-                    H[i][j] += J[k][i] * J[k][j];
-                }
-            }
-        }
-        // 填充 Hessian 的对称部分 (上三角)
-        for(int i=0; i<nParams; ++i) {
-            for(int j=i+1; j<nParams; ++j) {
-                H[i][j] = H[j][i];
-            }
-        }
-
-        bool stepAccepted = false;
-
-        // 5. 内部循环：尝试更新步长 (Levenberg-Marquardt 核心步骤)
-        // 如果新误差变大，则增大阻尼因子 lambda 并重试
-        for(int tryIter=0; tryIter<5; ++tryIter) {
-            QVector<QVector<double>> H_lm = H;
-
-            // 将阻尼因子加入 Hessian 对角线: H_ii = H_ii + lambda * (1 + |H_ii|) 或 simplified: H_ii + lambda
-            // 这里采用 Marquardt 建议的方式
-            for(int i=0; i<nParams; ++i) {
-                H_lm[i][i] += lambda * (1.0 + std::abs(H[i][i]));
-            }
-
-            QVector<double> negG(nParams);
-            for(int i=0;i<nParams;++i) negG[i] = -g[i];
-
-            // 求解线性方程组 (H_lm * delta = -g) 得到参数更新量 delta
-            QVector<double> delta = solveLinearSystem(H_lm, negG);
-
-            // 计算试探性新参数
-            QMap<QString, double> trialMap = currentParamMap;
-            for(int i=0; i<nParams; ++i) {
-                int pIdx = fitIndices[i];
-                QString pName = params[pIdx].name;
-                double oldVal = currentParamMap[pName];
-
-                // 判断参数是否需要在对数域更新 (大部分试井参数如 k, C, S 为对数敏感，但 S 和 nf 除外)
-                bool isLog = (oldVal > 1e-12 && pName != "S" && pName != "nf");
-                double newVal;
-
-                if(isLog) {
-                    // 对数域更新: new = 10^(log(old) + delta)
-                    double logVal = log10(oldVal) + delta[i];
-                    newVal = pow(10.0, logVal);
-                } else {
-                    // 线性域更新: new = old + delta
-                    newVal = oldVal + delta[i];
-                }
-
-                // 强制约束参数范围 (Min/Max)
-                newVal = qMax(params[pIdx].min, qMin(newVal, params[pIdx].max));
-                trialMap[pName] = newVal;
-            }
-
-            // 参数联动更新
-            if(trialMap.contains("L") && trialMap.contains("Lf") && trialMap["L"] > 1e-9)
-                trialMap["LfD"] = trialMap["Lf"] / trialMap["L"];
-
-            // 计算新参数下的残差和误差
-            QVector<double> newRes = calculateResiduals(trialMap, modelType, weight);
-            double newSSE = calculateSumSquaredError(newRes);
-
-            // 6. 评估更新结果
-            if(newSSE < currentSSE) {
-                // 成功：接受新参数，减小阻尼因子，进入下一次迭代
-                currentSSE = newSSE;
-                currentParamMap = trialMap;
-                residuals = newRes;
-                lambda /= 10.0;
-                stepAccepted = true;
-
-                // 刷新界面曲线
-                ModelCurveData iterCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-                emit sigIterationUpdated(currentSSE/nRes, currentParamMap, std::get<0>(iterCurve), std::get<1>(iterCurve), std::get<2>(iterCurve));
-                break;
-            } else {
-                // 失败：误差增加，拒绝更新，增大阻尼因子重试
-                lambda *= 10.0;
-            }
-        }
-
-        // 如果 lambda 过大仍无法下降，认为已陷入局部极小值，终止
-        if(!stepAccepted && lambda > 1e10) break;
-    }
-
-    // 7. 拟合结束处理
-    // 恢复高精度模式并计算最终曲线
-    if(m_modelManager) m_modelManager->setHighPrecision(true);
-
-    if(currentParamMap.contains("L") && currentParamMap.contains("Lf") && currentParamMap["L"] > 1e-9)
-        currentParamMap["LfD"] = currentParamMap["Lf"] / currentParamMap["L"];
-
-    ModelCurveData finalCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-    emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(finalCurve), std::get<1>(finalCurve), std::get<2>(finalCurve));
-
-    // 通知主线程完成
-    QMetaObject::invokeMethod(this, "onFitFinished");
-}
-
-/**
- * @brief 计算残差向量
- * @return 包含压差残差和导数残差的向量
- */
-QVector<double> FittingWidget::calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight) {
-    if(!m_modelManager || m_obsTime.isEmpty()) return QVector<double>();
-
-    // 调用模型管理器计算理论曲线
-    ModelCurveData res = m_modelManager->calculateTheoreticalCurve(modelType, params, m_obsTime);
-    const QVector<double>& pCal = std::get<1>(res);
-    const QVector<double>& dpCal = std::get<2>(res);
-
-    QVector<double> r;
-    double wp = weight;
-    double wd = 1.0 - weight;
-
-    // 计算压差残差 (基于对数差，更符合试井双对数图的拟合需求)
-    // 注意：m_obsDeltaP 已经是压差
-    int count = qMin(m_obsDeltaP.size(), pCal.size());
-    for(int i=0; i<count; ++i) {
-        if(m_obsDeltaP[i] > 1e-10 && pCal[i] > 1e-10)
-            r.append( (log(m_obsDeltaP[i]) - log(pCal[i])) * wp );
-        else
-            r.append(0.0);
-    }
-
-    // 计算导数残差
-    int dCount = qMin(m_obsDerivative.size(), dpCal.size());
-    dCount = qMin(dCount, count);
-    for(int i=0; i<dCount; ++i) {
-        if(m_obsDerivative[i] > 1e-10 && dpCal[i] > 1e-10)
-            r.append( (log(m_obsDerivative[i]) - log(dpCal[i])) * wd );
-        else
-            r.append(0.0);
-    }
-    return r;
-}
-
-/**
- * @brief 计算雅可比矩阵 (数值微分法)
- * @return J 矩阵
- */
-QVector<QVector<double>> FittingWidget::computeJacobian(const QMap<QString, double>& params, const QVector<double>& baseResiduals, const QVector<int>& fitIndices, ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams, double weight) {
-    int nRes = baseResiduals.size();
-    int nParams = fitIndices.size();
-    QVector<QVector<double>> J(nRes, QVector<double>(nParams));
-
-    for(int j = 0; j < nParams; ++j) {
-        int idx = fitIndices[j];
-        QString pName = currentFitParams[idx].name;
-        double val = params.value(pName);
-        bool isLog = (val > 1e-12 && pName != "S" && pName != "nf");
-
-        // 计算中心差分步长 h
-        double h;
-        QMap<QString, double> pPlus = params;
-        QMap<QString, double> pMinus = params;
-
-        if(isLog) {
-            h = 0.01; // 对数域步长
-            double valLog = log10(val);
-            pPlus[pName] = pow(10.0, valLog + h);
-            pMinus[pName] = pow(10.0, valLog - h);
-        } else {
-            h = 1e-4; // 线性域步长
-            pPlus[pName] = val + h;
-            pMinus[pName] = val - h;
-        }
-
-        // 联动更新
-        auto updateDeps = [](QMap<QString,double>& map) { if(map.contains("L") && map.contains("Lf") && map["L"] > 1e-9) map["LfD"] = map["Lf"] / map["L"]; };
-        if(pName == "L" || pName == "Lf") { updateDeps(pPlus); updateDeps(pMinus); }
-
-        // 分别计算正向扰动和负向扰动的残差
-        QVector<double> rPlus = calculateResiduals(pPlus, modelType, weight);
-        QVector<double> rMinus = calculateResiduals(pMinus, modelType, weight);
-
-        // 中心差分公式: df/dx = (f(x+h) - f(x-h)) / 2h
-        if(rPlus.size() == nRes && rMinus.size() == nRes) {
-            for(int i=0; i<nRes; ++i) {
-                J[i][j] = (rPlus[i] - rMinus[i]) / (2.0 * h);
-            }
-        }
-    }
-    return J;
-}
-
-/**
- * @brief 求解线性方程组 Ax = b
- * 说明：使用 Eigen 库的 LDLT 分解求解对称正定矩阵，稳定性好。
- */
-QVector<double> FittingWidget::solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b) {
-    int n = b.size();
-    if (n == 0) return QVector<double>();
-
-    Eigen::MatrixXd matA(n, n);
-    Eigen::VectorXd vecB(n);
-
-    // 将 QVector 转换为 Eigen 数据格式
-    for (int i = 0; i < n; ++i) {
-        vecB(i) = b[i];
-        for (int j = 0; j < n; ++j) {
-            matA(i, j) = A[i][j];
-        }
-    }
-
-    // 求解
-    Eigen::VectorXd x = matA.ldlt().solve(vecB);
-
-    // 转换回 QVector
-    QVector<double> res(n);
-    for (int i = 0; i < n; ++i) res[i] = x(i);
-    return res;
-}
-
-/**
- * @brief 计算误差平方和 (SSE)
- */
-double FittingWidget::calculateSumSquaredError(const QVector<double>& residuals) {
-    double sse = 0.0;
-    for(double v : residuals) sse += v*v;
-    return sse;
-}
-
 // ===========================================================================
 // 其他辅助逻辑
 // ===========================================================================
@@ -919,7 +724,10 @@ void FittingWidget::updateModelCurve() {
         for(double e = -4; e <= 4; e += 0.1) targetT.append(pow(10, e));
     }
 
-    ModelCurveData res = m_modelManager->calculateTheoreticalCurve(type, currentParams, targetT);
+    // 观测时间点很多时在对数粗网格上反演后插值到观测时间
+    ModelSolverOptions options;
+    options.interpolate = true;
+    ModelCurveData res = m_modelManager->calculateTheoreticalCurve(type, currentParams, targetT, options);
     // 直接复用 onIterationUpdate 来刷新界面
     onIterationUpdate(0, currentParams, std::get<0>(res), std::get<1>(res), std::get<2>(res));
 }
@@ -929,6 +737,16 @@ void FittingWidget::updateModelCurve() {
  */
 void FittingWidget::onIterationUpdate(double err, const QMap<QString,double>& p,
                                       const QVector<double>& t, const QVector<double>& p_curve, const QVector<double>& d_curve) {
+    showFitValues(err, p);
+
+    // 绘制曲线
+    plotCurves(t, p_curve, d_curve, true);
+}
+
+/**
+ * @brief 刷新误差标签与参数表数值
+ */
+void FittingWidget::showFitValues(double err, const QMap<QString,double>& p) {
     // 更新误差标签
     ui->label_Error->setText(QString("误差(MSE): %1").arg(err, 0, 'e', 3));
 
@@ -942,18 +760,145 @@ void FittingWidget::onIterationUpdate(double err, const QMap<QString,double>& p,
         }
     }
     ui->tableParams->blockSignals(false);
+}
 
-    // 绘制曲线
-    plotCurves(t, p_curve, d_curve, true);
+/**
+ * @brief 定时读取拟合进度
+ * 有新快照时立即刷新误差与参数表 (开销很小)，曲线交给预览线程计算；进度条由任务的 QFuture 进度驱动。
+ */
+void FittingWidget::onProgressTimer() {
+    if(!m_previewActive || !m_fitJob) return;
+    if(!m_watcher.isStarted()) {
+        int position = FitScheduler::instance()->queuePosition(m_fitJob.get());
+        if(position > 0) setFitStatus(QString("排队中 #%1").arg(position));
+        return;
+    }
+    FitProgressSnapshot snapshot;
+    if(!m_fitJob->takeProgress(snapshot)) return;
+
+    showFitValues(snapshot.mse, snapshot.params.toMap());
+    m_previewParams = snapshot.params;
+    requestPreviewCurve();
+}
+
+/**
+ * @brief 计算预览曲线
+ * 同一时刻最多一个预览任务；计算期间到达的参数只保留最新一组，任务结束后重算。
+ * 拟合结束后尚未开始的任务直接放弃，已完成的结果不再绘制；结果按预览代数核对，不会画到之后开始的拟合上。
+ */
+void FittingWidget::requestPreviewCurve() {
+    if(m_previewRunning) {
+        m_previewPending = true;
+        return;
+    }
+    m_previewRunning = true;
+    m_previewPending = false;
+
+    ModelParamVector params = m_previewParams;
+    ModelManager::ModelType modelType = m_fitJob ? m_fitJob->settings().modelType : m_currentModelType;
+    const int generation = m_previewGeneration;
+    m_previewFuture = FitScheduler::instance()->runInteractive([this, params, modelType, generation]() {
+        ModelCurveData curve;
+        bool valid = m_previewActive && generation == m_previewGeneration;
+        if(valid) curve = m_modelManager->calculateTheoreticalCurve(modelType, params, QVector<double>(), ModelSolverOptions(false));
+
+        QMetaObject::invokeMethod(this, [this, curve, valid, generation]() {
+            m_previewRunning = false;
+            if(valid && m_previewActive && generation == m_previewGeneration)
+                plotCurves(std::get<0>(curve), std::get<1>(curve), std::get<2>(curve), true);
+            // 期间收到的参数 (可能属于新开始的拟合) 继续计算
+            if(m_previewPending && m_previewActive) requestPreviewCurve();
+        }, Qt::QueuedConnection);
+    });
 }
 
 /**
  * @brief 拟合完成槽函数
+ * 停止预览后显示最终参数与高精度曲线；任务被取消时没有结果。
  */
 void FittingWidget::onFitFinished() {
     m_isFitting = false;
+    m_progressTimer.stop();
+    m_previewActive = false;
+    ++m_previewGeneration;
     ui->btnRunFit->setEnabled(true);
-    QMessageBox::information(this, "完成", "拟合完成。");
+    ui->btnGlobalFit->setEnabled(true);
+
+    QFuture<FitJobResult> future = m_watcher.future();
+    bool global = m_fitJob && m_fitJob->settings().global;
+    m_fitJob.reset();
+    if(future.isCanceled() || future.resultCount() == 0) {
+        setFitStatus("已取消");
+        return;
+    }
+
+    m_fitResult = future.result();
+    setFitStatus(m_fitResult.stopped ? "已停止" : "完成");
+    if(m_fitResult.valid) {
+        onIterationUpdate(m_fitResult.mse, m_fitResult.params.toMap(),
+                          std::get<0>(m_fitResult.curve), std::get<1>(m_fitResult.curve), std::get<2>(m_fitResult.curve));
+    }
+    if(global) {
+        showGlobalFitResults();
+        return;
+    }
+    const FitIterationStats& stats = m_fitResult.stats;
+    QString summary = QString("%1: 迭代 %2 次，完整计算雅可比矩阵 %3 次，Broyden 秩一更新 %4 次，残差计算 %5 次。")
+                          .arg(m_fitResult.stopped ? QString("拟合已停止") : QString("拟合完成"))
+                          .arg(stats.iterations).arg(stats.jacobianEvaluations)
+                          .arg(stats.broydenUpdates).arg(stats.residualEvaluations);
+    if(stats.generations > 0) summary += QString("\n差分进化 %1 代。").arg(stats.generations);
+    if(stats.shiftEvaluations > 0) summary += QString("\n时间平移搜索计算残差 %1 次。").arg(stats.shiftEvaluations);
+    showFitSummary(summary);
+}
+
+/**
+ * @brief 在误差标签下方显示拟合结束摘要 (空字符串隐藏)；页签状态仍由 setFitStatus 显示
+ */
+void FittingWidget::showFitSummary(const QString& summary) {
+    ui->label_FitSummary->setText(summary);
+    ui->label_FitSummary->setVisible(!summary.isEmpty());
+}
+
+/**
+ * @brief 更新拟合任务状态，状态变化时通知所在页面
+ */
+void FittingWidget::setFitStatus(const QString& status) {
+    if(status == m_fitStatus) return;
+    m_fitStatus = status;
+    emit sigFitStatusChanged(status);
+}
+
+/**
+ * @brief 显示全局拟合结果列表
+ * 界面已显示误差最小的解；用户改选其他候选时以高精度设置重新计算该解的曲线并写回参数表。
+ */
+void FittingWidget::showGlobalFitResults() {
+    if(m_fitResult.candidates.isEmpty()) {
+        showFitSummary("全局拟合已结束，没有可用的候选解。");
+        return;
+    }
+
+    QVector<QVector<double>> values;
+    for(const MultiStartCandidate& c : m_fitResult.candidates) {
+        ModelParamVector p = m_fitResult.variables.toParams(c.x);
+        QVector<double> row;
+        for(int id : m_fitResult.variables.fitIds) row.append(p[id]);
+        values.append(row);
+    }
+    QString summary = QString("全局拟合完成: 共 %1 个起点，试探步 %2 次，完整计算雅可比矩阵 %3 次，残差计算 %4 次。\n"
+                              "误差为抽稀数据上的均方误差，提前淘汰的候选为截断时的结果。")
+                          .arg(m_fitResult.candidates.size()).arg(m_fitResult.stats.iterations)
+                          .arg(m_fitResult.stats.jacobianEvaluations).arg(m_fitResult.stats.residualEvaluations);
+
+    MultiStartResultDialog dlg(m_fitResult.candidates, m_fitResult.variables.displayNames, values, summary, this);
+    if(dlg.exec() != QDialog::Accepted) return;
+    int k = dlg.selectedCandidate();
+    if(k <= 0 || k >= m_fitResult.candidates.size()) return; // 第一行 (误差最小) 已在界面上
+
+    ModelParamVector p = m_fitResult.variables.toParams(m_fitResult.candidates[k].x);
+    ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(m_currentModelType, p);
+    onIterationUpdate(m_fitResult.candidates[k].mse, p.toMap(), std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
 }
 
 /**
@@ -1107,6 +1052,14 @@ QJsonObject FittingWidget::getJsonState() const
     root["modelType"] = (int)m_currentModelType;
     root["modelName"] = ModelManager::getModelTypeName(m_currentModelType);
     root["fitWeightVal"] = ui->sliderWeight->value();
+    root["fitPointsPerDecade"] = ui->spinPointsPerDecade->value();
+    root["fitBroydenUpdate"] = ui->chkBroydenUpdate->isChecked();
+    root["fitVariableProjection"] = ui->chkVariableProjection->isChecked();
+    root["fitProjectTimeShift"] = ui->chkProjectTimeShift->isChecked();
+    root["globalFitStarts"] = ui->spinGlobalStarts->value();
+    root["fitOptimizer"] = ui->comboOptimizer->currentIndex();
+    root["fitPolishLM"] = ui->chkPolishLM->isChecked();
+    root["fitInversionTolerance"] = ui->comboInversionAccuracy->currentData().toDouble();
 
     QJsonObject plotRange;
     plotRange["xMin"] = m_plot->xAxis->range().lower;
@@ -1190,6 +1143,32 @@ void FittingWidget::loadFittingState(const QJsonObject& root)
         ui->sliderWeight->setValue((int)(w * 100));
     }
 
+    if (root.contains("fitPointsPerDecade")) {
+        ui->spinPointsPerDecade->setValue(root["fitPointsPerDecade"].toInt());
+    }
+    if (root.contains("fitBroydenUpdate")) {
+        ui->chkBroydenUpdate->setChecked(root["fitBroydenUpdate"].toBool());
+    }
+    if (root.contains("fitVariableProjection")) {
+        ui->chkVariableProjection->setChecked(root["fitVariableProjection"].toBool());
+    }
+    if (root.contains("fitProjectTimeShift")) {
+        ui->chkProjectTimeShift->setChecked(root["fitProjectTimeShift"].toBool());
+    }
+    if (root.contains("globalFitStarts")) {
+        ui->spinGlobalStarts->setValue(root["globalFitStarts"].toInt());
+    }
+    if (root.contains("fitOptimizer")) {
+        ui->comboOptimizer->setCurrentIndex(root["fitOptimizer"].toInt());
+    }
+    if (root.contains("fitPolishLM")) {
+        ui->chkPolishLM->setChecked(root["fitPolishLM"].toBool());
+    }
+    if (root.contains("fitInversionTolerance")) {
+        int index = ui->comboInversionAccuracy->findData(root["fitInversionTolerance"].toDouble());
+        if (index >= 0) ui->comboInversionAccuracy->setCurrentIndex(index);
+    }
+
     if (root.contains("observedData")) {
         QJsonObject obs = root["observedData"].toObject();
         QJsonArray tArr = obs["time"].toArray();
@@ -3,7 +3,7 @@
  * 文件作用: 试井拟合分析主界面类的头文件
  * 功能描述:
  * 1. 定义拟合分析界面的主要控件成员变量和布局逻辑。
- * 2. 声明用于Levenberg-Marquardt非线性回归拟合的核心算法函数。
+ * 2. 声明拟合问题 (残差、雅可比矩阵) 的构造函数，迭代由 Levenberg-Marquardt 求解器完成。
  * 3. 声明观测数据（时间、压差、导数）的管理函数。
  * 4. 提供与外部模块（如主窗口、模型管理器）的交互接口。
  */
@@ -15,6 +15,7 @@
 #include <QMap>
 #include <QVector>
 #include <QFutureWatcher>
+#include <QTimer>
 #include <QJsonObject>
 #include <QStandardItemModel>
 #include "modelmanager.h"
@@ -22,6 +23,10 @@
 #include "chartsetting1.h"
 #include "fittingparameterchart.h"
 #include "paramselectdialog.h"
+#include "logtimeresampler.h"
+#include "fitjob.h"
+#include <atomic>
+#include <memory>
 
 namespace Ui { class FittingWidget; }
 
@@ -67,6 +72,9 @@ signals:
     // 请求父级页面保存项目的信号
     void sigRequestSave();
 
+    // 拟合任务状态变更信号 (排队、进度、结束)，空字符串表示无拟合任务，用于页签状态显示
+    void sigFitStatusChanged(const QString& status);
+
 private slots:
     // 按钮槽函数：点击加载观测数据
     void on_btnLoadData_clicked();
@@ -74,6 +82,9 @@ private slots:
     // 按钮槽函数：点击开始拟合
     void on_btnRunFit_clicked();
 
+    // 按钮槽函数：点击全局拟合 (多起点)
+    void on_btnGlobalFit_clicked();
+
     // 按钮槽函数：点击停止拟合
     void on_btnStop_clicked();
 
@@ -110,6 +121,9 @@ private slots:
     // 内部逻辑槽：处理迭代更新信号，刷新UI
     void onIterationUpdate(double err, const QMap<QString,double>& p, const QVector<double>& t, const QVector<double>& p_curve, const QVector<double>& d_curve);
 
+    // 内部逻辑槽：按固定帧率读取拟合进度，刷新误差、参数表并请求预览曲线
+    void onProgressTimer();
+
     // 内部逻辑槽：处理拟合完成后的收尾工作
     void onFitFinished();
 
@@ -134,8 +148,19 @@ private:
 
     // 拟合任务控制状态
     bool m_isFitting;                      // 是否正在拟合中
-    bool m_stopRequested;                  // 是否收到了停止请求
-    QFutureWatcher<void> m_watcher;        // 异步任务监视器
+    std::shared_ptr<FitJob> m_fitJob;      // 正在运行的拟合任务 (持有数据与设置快照)
+    QFutureWatcher<FitJobResult> m_watcher; // 拟合任务监视器 (进度与完成通知)
+    FitJobResult m_fitResult;              // 最近一次拟合的结果 (全局拟合结果列表使用)
+    QString m_fitStatus;                   // 当前拟合任务状态文字 (页签显示)
+
+    // 拟合进度显示: 拟合线程只写入任务的无锁槽，界面定时读取，预览曲线以交互优先级在 Qt 全局线程池中按需计算
+    QTimer m_progressTimer;                // 拟合进度刷新定时器 (固定帧率)
+    std::atomic<bool> m_previewActive{false}; // 是否接受预览 (拟合结束后置为 false，丢弃未完成的预览)
+    std::atomic<int> m_previewGeneration{0};  // 预览代数 (拟合开始与结束时加一，代数不符的预览结果属于之前的拟合，丢弃)
+    bool m_previewRunning;                 // 是否有预览曲线正在计算
+    bool m_previewPending;                 // 计算期间是否收到了更新的参数
+    ModelParamVector m_previewParams;      // 最近一次读取的参数
+    QFuture<void> m_previewFuture;         // 正在计算的预览任务
 
     // 初始化绘图控件的样式和布局
     void setupPlot();
@@ -146,23 +171,23 @@ private:
     // 根据当前参数表的值，计算并更新理论曲线
     void updateModelCurve();
 
-    // 启动非线性回归优化任务（在子线程运行）
-    void runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight);
+    // 校验数据、读取拟合设置并启动拟合任务 (global 为真时运行多起点全局拟合)
+    void startFitting(bool global);
 
-    // Levenberg-Marquardt 算法的具体实现
-    void runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight);
+    // 以最近读取的参数计算预览曲线 (已有任务在计算时只记录请求，任务结束后以最新参数重算)
+    void requestPreviewCurve();
 
-    // 计算当前参数下的残差向量（理论值与观测值的差异）
-    QVector<double> calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight);
+    // 刷新误差标签与参数表数值
+    void showFitValues(double err, const QMap<QString,double>& p);
 
-    // 计算雅可比矩阵（残差对各个待拟合参数的偏导数）
-    QVector<QVector<double>> computeJacobian(const QMap<QString, double>& params, const QVector<double>& residuals, const QVector<int>& fitIndices, ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams, double weight);
+    // 显示全局拟合结果列表，采用用户选中的解
+    void showGlobalFitResults();
 
-    // 求解线性方程组 (Ax = b)，用于LM算法中的迭代步长计算
-    QVector<double> solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b);
+    // 更新拟合任务状态 (变化时发出 sigFitStatusChanged)
+    void setFitStatus(const QString& status);
 
-    // 计算残差平方和（SSE），作为目标函数值
-    double calculateSumSquaredError(const QVector<double>& residuals);
+    // 显示拟合结束摘要 (非模态标签，空字符串隐藏)
+    void showFitSummary(const QString& summary);
 
     // 获取图表的Base64编码字符串，用于生成HTML报告
     QString getPlotImageBase64();